@@ -0,0 +1,302 @@
+#include "bench_harness.h"
+#include <math.h>
+
+#include <fcntl.h>
+
+#ifdef PLATFORM_WINDOWS
+#define NOGDI
+#include <windows.h>
+#include <io.h>
+#define BENCH_NULL_DEVICE "NUL"
+#define bench_fileno _fileno
+#define bench_dup _dup
+#define bench_dup2 _dup2
+#define bench_open _open
+#define bench_close _close
+#define BENCH_O_WRONLY _O_WRONLY
+#else
+#include <time.h>
+#include <unistd.h>
+#define BENCH_NULL_DEVICE "/dev/null"
+#define bench_fileno fileno
+#define bench_dup dup
+#define bench_dup2 dup2
+#define bench_open open
+#define bench_close close
+#define BENCH_O_WRONLY O_WRONLY
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define BENCH_HAVE_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC
+#endif
+
+volatile int64_t bench_sink_int;
+volatile double bench_sink_double;
+const void* volatile bench_sink_pointer;
+
+// 标定时单轮迭代次数的上限，防止空函数无限倍增
+#define BENCH_MAX_ITERATIONS (1ULL << 32)
+
+double bench_now_seconds(void) {
+#ifdef PLATFORM_WINDOWS
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+uint64_t bench_read_cycles(void) {
+#ifdef BENCH_HAVE_TSC
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+int bench_stdout_silence(void) {
+    fflush(stdout);
+    int stdout_fd = bench_fileno(stdout);
+    int saved_fd = bench_dup(stdout_fd);
+    if (saved_fd < 0) {
+        return -1;
+    }
+
+    int null_fd = bench_open(BENCH_NULL_DEVICE, BENCH_O_WRONLY);
+    if (null_fd < 0) {
+        bench_close(saved_fd);
+        return -1;
+    }
+    bench_dup2(null_fd, stdout_fd);
+    bench_close(null_fd);
+    return saved_fd;
+}
+
+void bench_stdout_restore(int saved_fd) {
+    if (saved_fd < 0) {
+        return;
+    }
+
+    fflush(stdout);
+    bench_dup2(saved_fd, bench_fileno(stdout));
+    bench_close(saved_fd);
+}
+
+void bench_options_init(BenchOptions* options) {
+    options->filter = NULL;
+    options->samples = BENCH_DEFAULT_SAMPLES;
+    options->min_sample_seconds = BENCH_DEFAULT_MIN_SAMPLE_SECONDS;
+    options->warmup_seconds = BENCH_DEFAULT_WARMUP_SECONDS;
+    options->hardware_counters = true;
+}
+
+Status bench_runner_init(BenchRunner* runner, const BenchOptions* options) {
+    if (!runner || !options || options->samples == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    runner->options = *options;
+    runner->results = NULL;
+    runner->count = 0;
+    runner->capacity = 0;
+    runner->suite = "";
+    runner->counters = options->hardware_counters ? perf_counters_create() : NULL;
+    return STATUS_SUCCESS;
+}
+
+void bench_runner_free(BenchRunner* runner) {
+    if (runner) {
+        free(runner->results);
+        runner->results = NULL;
+        runner->count = 0;
+        runner->capacity = 0;
+        perf_counters_destroy(runner->counters);
+        runner->counters = NULL;
+    }
+}
+
+void bench_set_suite(BenchRunner* runner, const char* suite) {
+    runner->suite = suite;
+}
+
+static bool bench_matches_filter(const BenchRunner* runner, const char* name) {
+    if (!runner->options.filter || runner->options.filter[0] == '\0') {
+        return true;
+    }
+
+    char full_name[sizeof(((BenchResult*)0)->suite) + sizeof(((BenchResult*)0)->name) + 1];
+    snprintf(full_name, sizeof(full_name), "%s/%s", runner->suite, name);
+    return strstr(full_name, runner->options.filter) != NULL;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double bench_time_once(BenchFunc func, void* ctx, uint64_t iterations) {
+    BENCH_CLOBBER();
+    double start = bench_now_seconds();
+    func((size_t)iterations, ctx);
+    double elapsed = bench_now_seconds() - start;
+    BENCH_CLOBBER();
+    return elapsed;
+}
+
+// 增加迭代次数直到一次采样至少持续min_sample_seconds
+static uint64_t bench_calibrate(BenchFunc func, void* ctx, double min_sample_seconds) {
+    uint64_t iterations = 1;
+
+    for (;;) {
+        double elapsed = bench_time_once(func, ctx, iterations);
+        if (elapsed >= min_sample_seconds || iterations >= BENCH_MAX_ITERATIONS) {
+            return iterations;
+        }
+
+        double factor = (elapsed > 0.0) ? min_sample_seconds / elapsed * 1.2 : 100.0;
+        factor = MAX(2.0, MIN(100.0, factor));
+        iterations = (uint64_t)((double)iterations * factor);
+    }
+}
+
+static void bench_fill_counter_metrics(BenchResult* result, uint32_t valid,
+                                       const uint64_t totals[PERF_COUNTER_COUNT], double operations) {
+    const uint32_t ipc_bits = PERF_COUNTER_BIT(PERF_COUNTER_CYCLES) | PERF_COUNTER_BIT(PERF_COUNTER_INSTRUCTIONS);
+
+    if ((valid & ipc_bits) == ipc_bits && totals[PERF_COUNTER_CYCLES] > 0) {
+        result->ipc = (double)totals[PERF_COUNTER_INSTRUCTIONS] / (double)totals[PERF_COUNTER_CYCLES];
+    } else {
+        valid &= ~ipc_bits;
+    }
+    result->branch_misses_per_op = (double)totals[PERF_COUNTER_BRANCH_MISSES] / operations;
+    result->l1d_misses_per_op = (double)totals[PERF_COUNTER_L1D_MISSES] / operations;
+    result->llc_misses_per_op = (double)totals[PERF_COUNTER_LLC_MISSES] / operations;
+    result->counters = valid & (PERF_COUNTER_BIT(PERF_COUNTER_COUNT) - 1);
+}
+
+const BenchResult* bench_run(BenchRunner* runner, const char* name, const char* params,
+                             BenchFunc func, void* ctx) {
+    if (!runner || !name || !func || !bench_matches_filter(runner, name)) {
+        return NULL;
+    }
+
+    if (runner->count == runner->capacity) {
+        size_t capacity = (runner->capacity > 0) ? runner->capacity * 2 : 64;
+        BenchResult* results = (BenchResult*)realloc(runner->results, capacity * sizeof(BenchResult));
+        if (!results) {
+            return NULL;
+        }
+        runner->results = results;
+        runner->capacity = capacity;
+    }
+
+    size_t sample_count = runner->options.samples;
+    double* samples = (double*)malloc(sample_count * sizeof(double));
+    if (!samples) {
+        return NULL;
+    }
+
+    uint64_t iterations = bench_calibrate(func, ctx, runner->options.min_sample_seconds);
+
+    double warmup_end = bench_now_seconds() + runner->options.warmup_seconds;
+    do {
+        bench_time_once(func, ctx, iterations);
+    } while (bench_now_seconds() < warmup_end);
+
+    // 计数器在计时区间之外启停，只有每个样本都读到的计数器才算有效
+    bool use_counters = perf_counters_available(runner->counters) != 0;
+    uint32_t counters_valid = use_counters ? ~0u : 0u;
+    uint64_t counter_totals[PERF_COUNTER_COUNT] = {0};
+
+    uint64_t total_cycles = 0;
+    for (size_t s = 0; s < sample_count; s++) {
+        if (use_counters && perf_counters_start(runner->counters) != STATUS_SUCCESS) {
+            counters_valid = 0;
+        }
+
+        uint64_t cycles_start = bench_read_cycles();
+        double elapsed = bench_time_once(func, ctx, iterations);
+        total_cycles += bench_read_cycles() - cycles_start;
+        samples[s] = elapsed * 1e9 / (double)iterations;
+
+        if (use_counters) {
+            PerfCounterValues values;
+            perf_counters_stop(runner->counters, &values);
+            counters_valid &= values.available;
+            for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+                counter_totals[c] += values.values[c];
+            }
+        }
+    }
+
+    BenchResult* result = &runner->results[runner->count++];
+    memset(result, 0, sizeof(*result));
+    snprintf(result->suite, sizeof(result->suite), "%s", runner->suite);
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    snprintf(result->params, sizeof(result->params), "%s", params ? params : "");
+    result->iterations = iterations;
+    result->samples = sample_count;
+
+    double sum = 0.0;
+    for (size_t s = 0; s < sample_count; s++) {
+        sum += samples[s];
+    }
+    result->mean_ns = sum / (double)sample_count;
+
+    double variance = 0.0;
+    for (size_t s = 0; s < sample_count; s++) {
+        variance += (samples[s] - result->mean_ns) * (samples[s] - result->mean_ns);
+    }
+    result->stddev_ns = (sample_count > 1) ? sqrt(variance / (double)(sample_count - 1)) : 0.0;
+
+    qsort(samples, sample_count, sizeof(double), compare_doubles);
+    result->min_ns = samples[0];
+    result->median_ns = (sample_count % 2) ? samples[sample_count / 2]
+                        : (samples[sample_count / 2 - 1] + samples[sample_count / 2]) / 2.0;
+    // 最近秩法：第ceil(0.99 * n)个样本
+    size_t p99_rank = (size_t)ceil(0.99 * (double)sample_count);
+    result->p99_ns = samples[MAX(p99_rank, (size_t)1) - 1];
+    result->cycles_per_op = (double)total_cycles / ((double)iterations * (double)sample_count);
+    bench_fill_counter_metrics(result, counters_valid, counter_totals,
+                               (double)iterations * (double)sample_count);
+
+    free(samples);
+    bench_print_result(result);
+    return result;
+}
+
+void bench_print_header(void) {
+    printf("%-12s %-28s %-16s %12s %12s %12s %10s %12s %6s %10s %10s %10s\n",
+           "suite", "benchmark", "params", "median ns", "p99 ns", "stddev ns", "cycles", "iterations",
+           "IPC", "br-miss/op", "L1-miss/op", "LLC-miss/op");
+}
+
+// 不可用的计数器显示为"-"
+static void print_counter_column(uint32_t counters, PerfCounterKind kind, double value, int width, int precision) {
+    if (counters & PERF_COUNTER_BIT(kind)) {
+        printf(" %*.*f", width, precision, value);
+    } else {
+        printf(" %*s", width, "-");
+    }
+}
+
+void bench_print_result(const BenchResult* result) {
+    printf("%-12s %-28s %-16s %12.2f %12.2f %12.2f %10.1f %12llu",
+           result->suite, result->name, result->params,
+           result->median_ns, result->p99_ns, result->stddev_ns, result->cycles_per_op,
+           (unsigned long long)result->iterations);
+    print_counter_column(result->counters, PERF_COUNTER_INSTRUCTIONS, result->ipc, 6, 2);
+    print_counter_column(result->counters, PERF_COUNTER_BRANCH_MISSES, result->branch_misses_per_op, 10, 3);
+    print_counter_column(result->counters, PERF_COUNTER_L1D_MISSES, result->l1d_misses_per_op, 10, 3);
+    print_counter_column(result->counters, PERF_COUNTER_LLC_MISSES, result->llc_misses_per_op, 10, 3);
+    printf("\n");
+    fflush(stdout);
+}
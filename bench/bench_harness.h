@@ -0,0 +1,95 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include "utils.h"
+
+// ============================================================================
+// 微基准测试框架
+//
+// 每个测试函数自己循环iterations次，避免每次操作都经过一次间接调用。
+// 框架先按最短采样时间标定iterations，预热后采集若干样本，按每次操作
+// 的纳秒数统计中位数、p99、均值和标准差。
+// ============================================================================
+
+typedef void (*BenchFunc)(size_t iterations, void* ctx);
+
+typedef struct {
+    const char* filter;           // 只运行"套件/名称"包含该子串的测试，NULL表示全部
+    size_t samples;               // 每个测试的采样次数
+    double min_sample_seconds;    // 每次采样的最短时间，不足时增加iterations
+    double warmup_seconds;        // 标定后的预热时间
+    bool hardware_counters;       // 采样时同时读取硬件性能计数器
+} BenchOptions;
+
+typedef struct {
+    char suite[32];
+    char name[64];
+    char params[64];
+    uint64_t iterations;          // 每次采样的操作次数
+    size_t samples;
+    double median_ns;             // 以下均为每次操作的纳秒数
+    double p99_ns;
+    double mean_ns;
+    double stddev_ns;
+    double min_ns;
+    double cycles_per_op;         // 时间戳计数器周期（不可用时为0）
+    uint32_t counters;            // 以下硬件计数器指标中有效的部分（PERF_COUNTER_BIT）
+    double ipc;                   // 每周期指令数，需要cycles和instructions
+    double branch_misses_per_op;
+    double l1d_misses_per_op;
+    double llc_misses_per_op;
+} BenchResult;
+
+typedef struct {
+    BenchOptions options;
+    BenchResult* results;
+    size_t count;
+    size_t capacity;
+    const char* suite;
+    PerfCounters* counters;       // 未启用或创建失败时为NULL
+} BenchRunner;
+
+#define BENCH_DEFAULT_SAMPLES 21
+#define BENCH_DEFAULT_MIN_SAMPLE_SECONDS 0.002
+#define BENCH_DEFAULT_WARMUP_SECONDS 0.02
+
+void bench_options_init(BenchOptions* options);
+Status bench_runner_init(BenchRunner* runner, const BenchOptions* options);
+void bench_runner_free(BenchRunner* runner);
+void bench_set_suite(BenchRunner* runner, const char* suite);
+// 运行一个测试并打印结果行；被过滤掉时返回NULL
+const BenchResult* bench_run(BenchRunner* runner, const char* name, const char* params,
+                             BenchFunc func, void* ctx);
+void bench_print_header(void);
+void bench_print_result(const BenchResult* result);
+
+double bench_now_seconds(void);
+uint64_t bench_read_cycles(void);
+
+// 把标准输出临时重定向到空设备，用于测量会打印的函数（测得的是格式化和写入的开销）。
+// 返回保存的原描述符，失败时返回-1；测试函数结束前必须调用bench_stdout_restore
+int bench_stdout_silence(void);
+void bench_stdout_restore(int saved_fd);
+
+// ============================================================================
+// 防止死代码消除
+// ============================================================================
+
+// 编译器屏障：阻止编译器跨越该点重排或合并内存访问
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define BENCH_CLOBBER() _ReadWriteBarrier()
+#else
+    #define BENCH_CLOBBER() __asm__ __volatile__("" ::: "memory")
+#endif
+
+// 把结果写入volatile变量，使计算结果被"使用"
+extern volatile int64_t bench_sink_int;
+extern volatile double bench_sink_double;
+extern const void* volatile bench_sink_pointer;
+
+#define BENCH_KEEP_INT(value) (bench_sink_int = (int64_t)(value))
+#define BENCH_KEEP_DOUBLE(value) (bench_sink_double = (double)(value))
+#define BENCH_KEEP_POINTER(value) (bench_sink_pointer = (const void*)(value))
+
+#endif // BENCH_HARNESS_H
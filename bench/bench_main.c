@@ -0,0 +1,163 @@
+#include "bench_suites.h"
+#include "bench_report.h"
+
+// ============================================================================
+// 函数级微基准测试
+//
+// 用法: bench [--filter 子串] [--samples N] [--min-time 毫秒]
+//             [--json 文件] [--csv 文件] [--no-counters]
+//             [--scaling [--max-size N] [--budget 秒] [--max-memory MB]]
+//       bench --compare 基准文件 当前文件 [--threshold 百分比] [--alpha p值]
+// 每行输出一个测试：每次操作耗时的中位数/p99/标准差(ns)、时间戳计数器
+// 周期数和每次采样的迭代次数，以及硬件计数器可用时的IPC和每次操作的
+// 分支预测失败、L1/LLC缓存缺失次数。结果只在Release构建下有意义。
+// --scaling改为运行规模扩展和线程数扩展测试（默认每个点5个样本）。
+// 比较模式下发现回归时退出码为1，便于在CI中作为发布门槛。
+// ============================================================================
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [--filter SUBSTRING] [--samples N] [--min-time MS] [--json FILE] [--csv FILE] [--no-counters]\n", program);
+    printf("       %s --scaling [--max-size N] [--budget SECONDS] [--max-memory MB] [other options]\n", program);
+    printf("       %s --compare BASELINE CURRENT [--threshold PERCENT] [--alpha P]\n", program);
+}
+
+static void print_counter_status(const PerfCounters* counters) {
+    uint32_t available = perf_counters_available(counters);
+    printf("Hardware counters:");
+    if (available == 0) {
+        printf(" unavailable\n");
+        return;
+    }
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (available & PERF_COUNTER_BIT(i)) {
+            printf(" %s", perf_counter_name((PerfCounterKind)i));
+        }
+    }
+    printf("\n");
+}
+
+static int run_compare(const char* baseline_file, const char* current_file,
+                       double threshold, double significance) {
+    BenchResultSet baseline, current;
+    if (bench_load_results(baseline_file, &baseline) != STATUS_SUCCESS) {
+        fprintf(stderr, "Failed to load %s\n", baseline_file);
+        return 2;
+    }
+    if (bench_load_results(current_file, &current) != STATUS_SUCCESS) {
+        fprintf(stderr, "Failed to load %s\n", current_file);
+        bench_result_set_free(&baseline);
+        return 2;
+    }
+
+    printf("=== Benchmark Comparison ===\n");
+    size_t regressions = 0;
+    bench_compare(&baseline, &current, threshold, significance, &regressions);
+
+    bench_result_set_free(&baseline);
+    bench_result_set_free(&current);
+    return (regressions > 0) ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    bench_options_init(&options);
+    const char* json_file = NULL;
+    const char* csv_file = NULL;
+    const char* compare_files[2] = {NULL, NULL};
+    double threshold = BENCH_DEFAULT_REGRESSION_THRESHOLD;
+    double significance = BENCH_DEFAULT_SIGNIFICANCE;
+    bool scaling = false;
+    bool samples_given = false;
+    ScalingOptions scaling_options;
+    bench_scaling_options_init(&scaling_options);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_file = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_file = argv[++i];
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 2 < argc) {
+            compare_files[0] = argv[++i];
+            compare_files[1] = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = strtod(argv[++i], NULL) / 100.0;
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            significance = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--scaling") == 0) {
+            scaling = true;
+        } else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            scaling_options.max_size = (size_t)strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            scaling_options.budget_seconds = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--max-memory") == 0 && i + 1 < argc) {
+            scaling_options.max_memory_mb = (size_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--no-counters") == 0) {
+            options.hardware_counters = false;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            options.samples = (size_t)strtoul(argv[++i], NULL, 10);
+            samples_given = true;
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            options.min_sample_seconds = strtod(argv[++i], NULL) / 1000.0;
+        } else {
+            print_usage(argv[0]);
+            return (strcmp(argv[i], "--help") == 0) ? 0 : 1;
+        }
+    }
+
+    if (compare_files[0]) {
+        return run_compare(compare_files[0], compare_files[1], threshold, significance);
+    }
+
+    // 大规模输入单次调用就要几百毫秒，扩展测试默认减少样本数
+    if (scaling && !samples_given) {
+        options.samples = 5;
+    }
+
+    BenchRunner runner;
+    if (bench_runner_init(&runner, &options) != STATUS_SUCCESS) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    printf("=== Utils Function Benchmark ===\n");
+    printf("Build: %s, %s\n", bench_build_config(), bench_compiler_name());
+    char features[128];
+    cpu_features_format(features, sizeof(features));
+    printf("CPU features: %s (scan: %s, gemm: %s)\n", features, scan_kernel_name(), gemm_kernel_name());
+    printf("Samples: %zu, min sample time: %.1f ms\n",
+           options.samples, options.min_sample_seconds * 1000.0);
+    print_counter_status(runner.counters);
+    printf("\n");
+    bench_print_header();
+
+    if (scaling) {
+        bench_suite_scaling(&runner, &scaling_options);
+        bench_suite_threads(&runner, &scaling_options);
+    } else {
+        bench_suite_calls(&runner);
+        bench_suite_math(&runner);
+        bench_suite_sort(&runner);
+        bench_suite_control(&runner);
+        bench_suite_lists(&runner);
+        bench_suite_data(&runner);
+        bench_suite_memory(&runner);
+        bench_suite_io(&runner);
+    }
+
+    printf("\n%zu benchmarks completed\n", runner.count);
+
+    int exit_code = 0;
+    if (json_file && bench_write_json(json_file, runner.results, runner.count) != STATUS_SUCCESS) {
+        fprintf(stderr, "Failed to write %s\n", json_file);
+        exit_code = 1;
+    }
+    if (csv_file && bench_write_csv(csv_file, runner.results, runner.count) != STATUS_SUCCESS) {
+        fprintf(stderr, "Failed to write %s\n", csv_file);
+        exit_code = 1;
+    }
+
+    bench_runner_free(&runner);
+    return exit_code;
+}
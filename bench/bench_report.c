@@ -0,0 +1,612 @@
+#include "bench_report.h"
+#include <math.h>
+#include <ctype.h>
+#include <stddef.h>
+
+#define BENCH_STRINGIFY_VALUE(x) #x
+#define BENCH_STRINGIFY(x) BENCH_STRINGIFY_VALUE(x)
+
+// CSV列和JSON键，读取时按名字查找，新增列不影响旧文件的读取
+static const char* const csv_columns[] = {
+    "suite", "function", "params", "config", "compiler", "iterations", "samples",
+    "ns_per_op", "mean_ns", "stddev_ns", "p99_ns", "min_ns", "cycles_per_op",
+    "ipc", "branch_misses_per_op", "l1d_misses_per_op", "llc_misses_per_op"
+};
+
+// 硬件计数器列与对应的计数器，不可用时JSON写null、CSV留空
+typedef struct {
+    const char* name;
+    PerfCounterKind kind;
+    size_t offset;
+} CounterField;
+
+static const CounterField counter_fields[] = {
+    {"ipc", PERF_COUNTER_INSTRUCTIONS, offsetof(BenchResult, ipc)},
+    {"branch_misses_per_op", PERF_COUNTER_BRANCH_MISSES, offsetof(BenchResult, branch_misses_per_op)},
+    {"l1d_misses_per_op", PERF_COUNTER_L1D_MISSES, offsetof(BenchResult, l1d_misses_per_op)},
+    {"llc_misses_per_op", PERF_COUNTER_LLC_MISSES, offsetof(BenchResult, llc_misses_per_op)},
+};
+
+#define COUNTER_FIELD_COUNT (sizeof(counter_fields) / sizeof(counter_fields[0]))
+
+static double counter_field_value(const BenchResult* r, const CounterField* field) {
+    return *(const double*)((const char*)r + field->offset);
+}
+
+#define CSV_COLUMN_COUNT (sizeof(csv_columns) / sizeof(csv_columns[0]))
+
+// ============================================================================
+// 构建信息
+// ============================================================================
+
+const char* bench_build_config(void) {
+#ifdef BENCH_BUILD_CONFIG
+    // 多配置生成器下是$<CONFIG>；单配置且未设置CMAKE_BUILD_TYPE时为空
+    if (BENCH_BUILD_CONFIG[0] != '\0') {
+        return BENCH_BUILD_CONFIG;
+    }
+#endif
+#ifdef NDEBUG
+    return "Release";
+#else
+    return "Debug";
+#endif
+}
+
+const char* bench_compiler_name(void) {
+#if defined(__clang__)
+    return "Clang " BENCH_STRINGIFY(__clang_major__) "." BENCH_STRINGIFY(__clang_minor__) "."
+           BENCH_STRINGIFY(__clang_patchlevel__);
+#elif defined(__GNUC__)
+    return "GCC " BENCH_STRINGIFY(__GNUC__) "." BENCH_STRINGIFY(__GNUC_MINOR__) "."
+           BENCH_STRINGIFY(__GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+    return "MSVC " BENCH_STRINGIFY(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+// ============================================================================
+// 写出
+// ============================================================================
+
+static void write_json_string(FILE* file, const char* str) {
+    fputc('"', file);
+    for (; *str; str++) {
+        if (*str == '"' || *str == '\\') {
+            fputc('\\', file);
+        }
+        if ((unsigned char)*str >= 0x20) {
+            fputc(*str, file);
+        }
+    }
+    fputc('"', file);
+}
+
+static void write_csv_string(FILE* file, const char* str) {
+    fputc('"', file);
+    for (; *str; str++) {
+        if (*str == '"') {
+            fputc('"', file);
+        }
+        fputc(*str, file);
+    }
+    fputc('"', file);
+}
+
+static Status close_written_file(FILE* file) {
+    bool failed = ferror(file) != 0;
+    failed |= fclose(file) != 0;
+    return failed ? STATUS_ERROR : STATUS_SUCCESS;
+}
+
+// 每条记录占一行，读取时按行解析
+Status bench_write_json(const char* filename, const BenchResult* results, size_t count) {
+    if (!filename || (!results && count > 0)) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        return STATUS_FILE_NOT_FOUND;
+    }
+
+    fprintf(file, "{\n  \"config\": ");
+    write_json_string(file, bench_build_config());
+    fprintf(file, ",\n  \"compiler\": ");
+    write_json_string(file, bench_compiler_name());
+    fprintf(file, ",\n  \"results\": [\n");
+
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(file, "    {\"suite\": ");
+        write_json_string(file, r->suite);
+        fprintf(file, ", \"function\": ");
+        write_json_string(file, r->name);
+        fprintf(file, ", \"params\": ");
+        write_json_string(file, r->params);
+        fprintf(file, ", \"config\": ");
+        write_json_string(file, bench_build_config());
+        fprintf(file, ", \"compiler\": ");
+        write_json_string(file, bench_compiler_name());
+        fprintf(file, ", \"iterations\": %llu, \"samples\": %zu, \"ns_per_op\": %.4f, "
+                      "\"mean_ns\": %.4f, \"stddev_ns\": %.4f, \"p99_ns\": %.4f, "
+                      "\"min_ns\": %.4f, \"cycles_per_op\": %.2f",
+                (unsigned long long)r->iterations, r->samples, r->median_ns,
+                r->mean_ns, r->stddev_ns, r->p99_ns, r->min_ns, r->cycles_per_op);
+        for (size_t f = 0; f < COUNTER_FIELD_COUNT; f++) {
+            const CounterField* field = &counter_fields[f];
+            if (r->counters & PERF_COUNTER_BIT(field->kind)) {
+                fprintf(file, ", \"%s\": %.4f", field->name, counter_field_value(r, field));
+            } else {
+                fprintf(file, ", \"%s\": null", field->name);
+            }
+        }
+        fprintf(file, "}%s\n", (i + 1 < count) ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+    return close_written_file(file);
+}
+
+Status bench_write_csv(const char* filename, const BenchResult* results, size_t count) {
+    if (!filename || (!results && count > 0)) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        return STATUS_FILE_NOT_FOUND;
+    }
+
+    for (size_t c = 0; c < CSV_COLUMN_COUNT; c++) {
+        fprintf(file, "%s%s", csv_columns[c], (c + 1 < CSV_COLUMN_COUNT) ? "," : "\n");
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        write_csv_string(file, r->suite);
+        fputc(',', file);
+        write_csv_string(file, r->name);
+        fputc(',', file);
+        write_csv_string(file, r->params);
+        fputc(',', file);
+        write_csv_string(file, bench_build_config());
+        fputc(',', file);
+        write_csv_string(file, bench_compiler_name());
+        fprintf(file, ",%llu,%zu,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f",
+                (unsigned long long)r->iterations, r->samples, r->median_ns,
+                r->mean_ns, r->stddev_ns, r->p99_ns, r->min_ns, r->cycles_per_op);
+        for (size_t f = 0; f < COUNTER_FIELD_COUNT; f++) {
+            const CounterField* field = &counter_fields[f];
+            if (r->counters & PERF_COUNTER_BIT(field->kind)) {
+                fprintf(file, ",%.4f", counter_field_value(r, field));
+            } else {
+                fputc(',', file);
+            }
+        }
+        fputc('\n', file);
+    }
+
+    return close_written_file(file);
+}
+
+// ============================================================================
+// 读取
+// ============================================================================
+
+static BenchResult* result_set_append(BenchResultSet* set) {
+    if (set->count == set->capacity) {
+        size_t capacity = (set->capacity > 0) ? set->capacity * 2 : 64;
+        BenchResult* results = (BenchResult*)realloc(set->results, capacity * sizeof(BenchResult));
+        if (!results) {
+            return NULL;
+        }
+        set->results = results;
+        set->capacity = capacity;
+    }
+
+    BenchResult* result = &set->results[set->count++];
+    memset(result, 0, sizeof(*result));
+    return result;
+}
+
+// 字符串字段放不下时报错，不截断（截断后的名称可能与其他测试混淆）
+static Status copy_string_field(char* dest, size_t dest_size, const char* value) {
+    size_t length = strlen(value);
+    if (length >= dest_size) {
+        return STATUS_ERROR;
+    }
+    memcpy(dest, value, length + 1);
+    return STATUS_SUCCESS;
+}
+
+// 按字段名填充结果，未知字段忽略；字符串字段超长时返回STATUS_ERROR
+static Status assign_field(BenchResultSet* set, BenchResult* r, const char* key, const char* value) {
+    if (strcmp(key, "suite") == 0) {
+        return copy_string_field(r->suite, sizeof(r->suite), value);
+    } else if (strcmp(key, "function") == 0) {
+        return copy_string_field(r->name, sizeof(r->name), value);
+    } else if (strcmp(key, "params") == 0) {
+        return copy_string_field(r->params, sizeof(r->params), value);
+    } else if (strcmp(key, "config") == 0) {
+        return copy_string_field(set->config, sizeof(set->config), value);
+    } else if (strcmp(key, "compiler") == 0) {
+        return copy_string_field(set->compiler, sizeof(set->compiler), value);
+    } else if (strcmp(key, "iterations") == 0) {
+        r->iterations = strtoull(value, NULL, 10);
+    } else if (strcmp(key, "samples") == 0) {
+        r->samples = (size_t)strtoul(value, NULL, 10);
+    } else if (strcmp(key, "ns_per_op") == 0) {
+        r->median_ns = strtod(value, NULL);
+    } else if (strcmp(key, "mean_ns") == 0) {
+        r->mean_ns = strtod(value, NULL);
+    } else if (strcmp(key, "stddev_ns") == 0) {
+        r->stddev_ns = strtod(value, NULL);
+    } else if (strcmp(key, "p99_ns") == 0) {
+        r->p99_ns = strtod(value, NULL);
+    } else if (strcmp(key, "min_ns") == 0) {
+        r->min_ns = strtod(value, NULL);
+    } else if (strcmp(key, "cycles_per_op") == 0) {
+        r->cycles_per_op = strtod(value, NULL);
+    } else {
+        for (size_t f = 0; f < COUNTER_FIELD_COUNT; f++) {
+            const CounterField* field = &counter_fields[f];
+            if (strcmp(key, field->name) == 0 && value[0] != '\0' && strcmp(value, "null") != 0) {
+                *(double*)((char*)r + field->offset) = strtod(value, NULL);
+                r->counters |= PERF_COUNTER_BIT(field->kind);
+            }
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+// 解析一行中的"key": value对，只支持本文件写出的扁平对象
+static Status parse_json_line(BenchResultSet* set, BenchResult* r, const char* line, const char* end) {
+    char key[32];
+    char value[128];
+    const char* p = line;
+
+    while (p < end) {
+        // 键
+        while (p < end && *p != '"') {
+            p++;
+        }
+        if (p >= end) {
+            return STATUS_SUCCESS;
+        }
+        size_t key_length = 0;
+        for (p++; p < end && *p != '"'; p++) {
+            if (key_length + 1 < sizeof(key)) {
+                key[key_length++] = *p;
+            }
+        }
+        key[key_length] = '\0';
+        p++;
+
+        while (p < end && isspace((unsigned char)*p)) {
+            p++;
+        }
+        if (p >= end || *p != ':') {
+            continue;
+        }
+        for (p++; p < end && isspace((unsigned char)*p); p++) {
+        }
+
+        // 值：字符串或数字，"results"后面的数组等其他值跳过
+        size_t value_length = 0;
+        if (p < end && *p == '"') {
+            for (p++; p < end && *p != '"'; p++) {
+                if (*p == '\\' && p + 1 < end) {
+                    p++;
+                }
+                if (value_length + 1 < sizeof(value)) {
+                    value[value_length++] = *p;
+                }
+            }
+            p++;
+        } else {
+            while (p < end && *p != ',' && *p != '}' && !isspace((unsigned char)*p)) {
+                if (value_length + 1 < sizeof(value)) {
+                    value[value_length++] = *p;
+                }
+                p++;
+            }
+        }
+        value[value_length] = '\0';
+        Status status = assign_field(set, r, key, value);
+        if (status != STATUS_SUCCESS) {
+            return status;
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+static Status load_json(char* content, BenchResultSet* set) {
+    BenchResult header;
+    char* line = content;
+
+    memset(&header, 0, sizeof(header));
+
+    while (*line) {
+        char* end = strchr(line, '\n');
+        if (!end) {
+            end = line + strlen(line);
+        }
+
+        // 含有"function"的行是一条记录，其余行是文件头
+        char saved = *end;
+        *end = '\0';
+        bool is_record = strstr(line, "\"function\"") != NULL;
+        *end = saved;
+
+        Status status;
+        if (is_record) {
+            BenchResult* r = result_set_append(set);
+            if (!r) {
+                return STATUS_OUT_OF_MEMORY;
+            }
+            status = parse_json_line(set, r, line, end);
+        } else {
+            status = parse_json_line(set, &header, line, end);
+        }
+        if (status != STATUS_SUCCESS) {
+            return status;
+        }
+        line = (*end) ? end + 1 : end;
+    }
+    return STATUS_SUCCESS;
+}
+
+// 拆出下一个CSV字段（支持双引号转义），返回下一字段的起始位置
+static const char* next_csv_field(const char* p, const char* end, char* field, size_t field_size) {
+    size_t length = 0;
+    bool quoted = (p < end && *p == '"');
+
+    if (quoted) {
+        for (p++; p < end; p++) {
+            if (*p == '"') {
+                if (p + 1 < end && p[1] == '"') {
+                    p++;
+                } else {
+                    p++;
+                    break;
+                }
+            }
+            if (length + 1 < field_size) {
+                field[length++] = *p;
+            }
+        }
+    }
+    for (; p < end && *p != ','; p++) {
+        if (!quoted && *p != '\r' && length + 1 < field_size) {
+            field[length++] = *p;
+        }
+    }
+    field[length] = '\0';
+    return (p < end) ? p + 1 : end;
+}
+
+#define CSV_MAX_COLUMNS 64
+
+static Status load_csv(char* content, BenchResultSet* set) {
+    char columns[CSV_MAX_COLUMNS][32];
+    size_t column_count = 0;
+    char field[128];
+    char* line = content;
+    bool header = true;
+
+    while (*line) {
+        char* end = strchr(line, '\n');
+        if (!end) {
+            end = line + strlen(line);
+        }
+
+        if (end > line && !(end - line == 1 && *line == '\r')) {
+            const char* p = line;
+            if (header) {
+                while (p < end && column_count < CSV_MAX_COLUMNS) {
+                    p = next_csv_field(p, end, columns[column_count], sizeof(columns[0]));
+                    column_count++;
+                }
+                header = false;
+            } else {
+                BenchResult* r = result_set_append(set);
+                if (!r) {
+                    return STATUS_OUT_OF_MEMORY;
+                }
+                for (size_t c = 0; c < column_count && p < end; c++) {
+                    p = next_csv_field(p, end, field, sizeof(field));
+                    Status status = assign_field(set, r, columns[c], field);
+                    if (status != STATUS_SUCCESS) {
+                        return status;
+                    }
+                }
+            }
+        }
+        line = (*end) ? end + 1 : end;
+    }
+
+    return header ? STATUS_ERROR : STATUS_SUCCESS;
+}
+
+Status bench_load_results(const char* filename, BenchResultSet* set) {
+    if (!filename || !set) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    memset(set, 0, sizeof(*set));
+    char* content = NULL;
+    size_t size = 0;
+    Status status = read_file_content(filename, &content, &size);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+
+    const char* first = content;
+    while (isspace((unsigned char)*first)) {
+        first++;
+    }
+
+    status = (*first == '{' || *first == '[') ? load_json(content, set) : load_csv(content, set);
+    free(content);
+    if (status != STATUS_SUCCESS) {
+        bench_result_set_free(set);
+    }
+    return status;
+}
+
+void bench_result_set_free(BenchResultSet* set) {
+    if (set) {
+        free(set->results);
+        set->results = NULL;
+        set->count = 0;
+        set->capacity = 0;
+    }
+}
+
+// ============================================================================
+// 比较
+// ============================================================================
+
+// 正则化不完全Beta函数的连分式部分（Lentz算法）
+static double incomplete_beta_fraction(double a, double b, double x) {
+    const double tiny = 1e-300;
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    d = 1.0 / ((fabs(d) < tiny) ? tiny : d);
+    double h = d;
+
+    for (int m = 1; m <= 200; m++) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d;
+        d = 1.0 / ((fabs(d) < tiny) ? tiny : d);
+        c = 1.0 + aa / c;
+        c = (fabs(c) < tiny) ? tiny : c;
+        h *= d * c;
+
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d;
+        d = 1.0 / ((fabs(d) < tiny) ? tiny : d);
+        c = 1.0 + aa / c;
+        c = (fabs(c) < tiny) ? tiny : c;
+        double delta = d * c;
+        h *= delta;
+        if (fabs(delta - 1.0) < 1e-12) {
+            break;
+        }
+    }
+    return h;
+}
+
+static double incomplete_beta(double a, double b, double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    if (x >= 1.0) {
+        return 1.0;
+    }
+
+    double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * incomplete_beta_fraction(a, b, x) / a;
+    }
+    return 1.0 - front * incomplete_beta_fraction(b, a, 1.0 - x) / b;
+}
+
+// Welch t检验：返回"current均值大于baseline均值"的单侧p值
+static double welch_slower_p_value(const BenchResult* baseline, const BenchResult* current) {
+    double n1 = (double)baseline->samples;
+    double n2 = (double)current->samples;
+    double v1 = baseline->stddev_ns * baseline->stddev_ns / n1;
+    double v2 = current->stddev_ns * current->stddev_ns / n2;
+    double se2 = v1 + v2;
+    double diff = current->mean_ns - baseline->mean_ns;
+
+    if (se2 <= 0.0) {
+        return (diff > 0.0) ? 0.0 : 1.0;
+    }
+
+    double t = diff / sqrt(se2);
+    double df = se2 * se2 / (v1 * v1 / (n1 - 1.0) + v2 * v2 / (n2 - 1.0));
+    double tail = 0.5 * incomplete_beta(df / 2.0, 0.5, df / (df + t * t));
+    return (t > 0.0) ? tail : 1.0 - tail;
+}
+
+static const BenchResult* find_result(const BenchResultSet* set, const BenchResult* key) {
+    for (size_t i = 0; i < set->count; i++) {
+        const BenchResult* r = &set->results[i];
+        if (strcmp(r->suite, key->suite) == 0 && strcmp(r->name, key->name) == 0 &&
+            strcmp(r->params, key->params) == 0) {
+            return r;
+        }
+    }
+    return NULL;
+}
+
+Status bench_compare(const BenchResultSet* baseline, const BenchResultSet* current,
+                     double threshold, double significance, size_t* regressions) {
+    if (!baseline || !current || !regressions) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    *regressions = 0;
+    printf("Baseline: %s, %s (%zu results)\n", baseline->config, baseline->compiler, baseline->count);
+    printf("Current:  %s, %s (%zu results)\n", current->config, current->compiler, current->count);
+    if (strcmp(baseline->config, current->config) != 0 || strcmp(baseline->compiler, current->compiler) != 0) {
+        printf("Warning: build configuration or compiler differs between the two files\n");
+    }
+    printf("Regression: mean slower by more than %.1f%% with one-sided p < %g\n\n",
+           threshold * 100.0, significance);
+
+    printf("%-12s %-28s %-16s %12s %12s %9s %9s  %s\n",
+           "suite", "benchmark", "params", "base ns", "current ns", "change", "p-value", "verdict");
+
+    size_t improvements = 0;
+    for (size_t i = 0; i < current->count; i++) {
+        const BenchResult* cur = &current->results[i];
+        const BenchResult* base = find_result(baseline, cur);
+        if (!base) {
+            printf("%-12s %-28s %-16s %12s %12.2f %9s %9s  new\n",
+                   cur->suite, cur->name, cur->params, "-", cur->mean_ns, "-", "-");
+            continue;
+        }
+
+        double change = (base->mean_ns > 0.0) ? (cur->mean_ns - base->mean_ns) / base->mean_ns : 0.0;
+        // 样本数不足时无法做t检验，只按阈值判断
+        bool testable = base->samples >= 2 && cur->samples >= 2;
+        double p_slower = testable ? welch_slower_p_value(base, cur) : 0.0;
+        const char* verdict = "";
+
+        if (change > threshold && p_slower < significance) {
+            verdict = "REGRESSION";
+            (*regressions)++;
+        } else if (change < -threshold && 1.0 - p_slower < significance) {
+            verdict = "faster";
+            improvements++;
+        }
+
+        char p_text[16];
+        if (testable) {
+            snprintf(p_text, sizeof(p_text), "%.4f", (change >= 0.0) ? p_slower : 1.0 - p_slower);
+        } else {
+            snprintf(p_text, sizeof(p_text), "n/a");
+        }
+        printf("%-12s %-28s %-16s %12.2f %12.2f %+8.1f%% %9s  %s\n",
+               cur->suite, cur->name, cur->params, base->mean_ns, cur->mean_ns,
+               change * 100.0, p_text, verdict);
+    }
+
+    for (size_t i = 0; i < baseline->count; i++) {
+        const BenchResult* base = &baseline->results[i];
+        if (!find_result(current, base)) {
+            printf("%-12s %-28s %-16s %12.2f %12s %9s %9s  missing\n",
+                   base->suite, base->name, base->params, base->mean_ns, "-", "-", "-");
+        }
+    }
+
+    printf("\n%zu regressions, %zu improvements\n", *regressions, improvements);
+    return STATUS_SUCCESS;
+}
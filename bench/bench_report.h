@@ -0,0 +1,39 @@
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include "bench_harness.h"
+
+// ============================================================================
+// 结果文件和回归比较
+//
+// 结果可以写成JSON或CSV，每条记录包含函数名、参数、构建配置、编译器、
+// 每次操作的中位数/均值/标准差和样本数。比较模式读入两份结果文件，
+// 对同名测试做Welch t检验：均值变慢超过阈值且统计显著时判为回归。
+// ============================================================================
+
+typedef struct {
+    BenchResult* results;
+    size_t count;
+    size_t capacity;
+    char config[32];            // 构建配置（Debug/Release等）
+    char compiler[64];
+} BenchResultSet;
+
+#define BENCH_DEFAULT_REGRESSION_THRESHOLD 0.05   // 均值至少变慢5%
+#define BENCH_DEFAULT_SIGNIFICANCE 0.01           // 单侧p值上限
+
+const char* bench_build_config(void);
+const char* bench_compiler_name(void);
+
+Status bench_write_json(const char* filename, const BenchResult* results, size_t count);
+Status bench_write_csv(const char* filename, const BenchResult* results, size_t count);
+
+// 按内容自动识别JSON或CSV格式
+Status bench_load_results(const char* filename, BenchResultSet* set);
+void bench_result_set_free(BenchResultSet* set);
+
+// 打印每个测试的变化，regressions返回判为回归的测试数
+Status bench_compare(const BenchResultSet* baseline, const BenchResultSet* current,
+                     double threshold, double significance, size_t* regressions);
+
+#endif // BENCH_REPORT_H
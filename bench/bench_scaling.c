@@ -0,0 +1,577 @@
+#include "bench_suites.h"
+#include <math.h>
+
+// ============================================================================
+// 规模扩展测试
+//
+// 按10的幂扫描输入规模，打印每个函数的吞吐量曲线（百万元素/秒），
+// 曲线下降的位置就是缓存容量或O(n^2)算法开始主导的位置。
+// 根据上一个规模的耗时和复杂度指数预测下一个规模的单次耗时，超过时间
+// 预算或内存上限的规模直接跳过，避免冒泡排序等在大规模下运行几个小时。
+// ============================================================================
+
+#define SCALING_MAX_DECADES 9                 // 10 .. 10^9
+#define SCALING_FILE "bench_scaling.tmp"
+#define LIST_NODE_BYTES 48                    // Node加上malloc的簿记开销
+
+typedef struct {
+    size_t size;
+    int* array;            // 打乱的原始数据
+    int* work;
+    LinkedList* list;
+    char* text;            // 字符串和文件测试用的缓冲区
+    size_t text_capacity;
+    size_t text_length;
+    int64_t sum;
+} ScalingContext;
+
+typedef struct {
+    const char* name;
+    int complexity;                   // 单次操作耗时随规模增长的指数
+    size_t bytes_per_element;         // 用于估算内存占用
+    Status (*setup)(ScalingContext* sc);
+    BenchFunc run;
+} ScalingCase;
+
+static void fill_random(int* values, size_t count, int modulus) {
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < count; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        values[i] = (int)(state % (uint32_t)modulus);
+    }
+}
+
+static void scaling_context_free(ScalingContext* sc) {
+    free(sc->array);
+    free(sc->work);
+    free(sc->text);
+    if (sc->list) {
+        destroy_linked_list(sc->list);
+    }
+    memset(sc, 0, sizeof(*sc));
+}
+
+// ============================================================================
+// 准备函数
+// ============================================================================
+
+static Status setup_array(ScalingContext* sc) {
+    sc->array = (int*)malloc(sc->size * sizeof(int));
+    sc->work = (int*)malloc(sc->size * sizeof(int));
+    if (!sc->array || !sc->work) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+    fill_random(sc->array, sc->size, 1000000);
+    memcpy(sc->work, sc->array, sc->size * sizeof(int));
+    return STATUS_SUCCESS;
+}
+
+static Status setup_list(ScalingContext* sc) {
+    sc->list = create_linked_list();
+    if (!sc->list) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < sc->size; i++) {
+        if (add_node(sc->list, (int)i) != STATUS_SUCCESS) {
+            return STATUS_OUT_OF_MEMORY;
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+static Status setup_text(ScalingContext* sc) {
+    sc->text_capacity = sc->size + 1;
+    sc->text = (char*)malloc(sc->text_capacity);
+    sc->work = (int*)malloc(sc->text_capacity);
+    if (!sc->text || !sc->work) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < sc->size; i++) {
+        sc->text[i] = (char)('a' + i % 26);
+    }
+    sc->text[sc->size] = '\0';
+    sc->text_length = sc->size;
+    return STATUS_SUCCESS;
+}
+
+// 整数数组和它的文本形式（每个数最多11个字符加分隔符）
+static Status setup_int_text(ScalingContext* sc) {
+    Status status = setup_array(sc);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+    sc->text_capacity = sc->size * (UTILS_INT32_MAX_CHARS + 1) + 1;
+    sc->text = (char*)malloc(sc->text_capacity);
+    if (!sc->text) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+    return format_int_array(sc->array, sc->size, ',', sc->text, sc->text_capacity, &sc->text_length);
+}
+
+static Status setup_file(ScalingContext* sc) {
+    Status status = setup_text(sc);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+    return write_file_content(SCALING_FILE, sc->text, sc->size);
+}
+
+// ============================================================================
+// 被测操作
+// ============================================================================
+
+static void run_array_operations(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        array_operations(sc->work, sc->size);
+        BENCH_CLOBBER();
+    }
+}
+
+static void run_sort_array(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        memcpy(sc->work, sc->array, sc->size * sizeof(int));
+        sort_array(sc->work, sc->size, NULL);
+        BENCH_CLOBBER();
+    }
+}
+
+static void run_scan_find_equal(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        BENCH_KEEP_INT(scan_find_equal(sc->array, sc->size, -1));
+    }
+}
+
+static void sum_chunk(const int* chunk, size_t count, void* ctx) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += chunk[i];
+    }
+    *(int64_t*)ctx += sum;
+}
+
+static void run_process_array_batched(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        sc->sum = 0;
+        process_array_batched(sc->array, sc->size, 0, sum_chunk, &sc->sum);
+        BENCH_KEEP_INT(sc->sum);
+    }
+}
+
+static void run_list_build(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        LinkedList* list = create_linked_list();
+        if (!list) {
+            return;
+        }
+        for (size_t n = 0; n < sc->size; n++) {
+            add_node(list, (int)n);
+        }
+        BENCH_KEEP_POINTER(list->tail);
+        destroy_linked_list(list);
+    }
+}
+
+static void run_find_node(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        // 查找最后一个节点，遍历整个链表
+        BENCH_KEEP_POINTER(find_node(sc->list, (int)(sc->size - 1)));
+    }
+}
+
+static void run_string_operations(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        string_operations((char*)sc->work, sc->text, sc->text_capacity);
+        BENCH_CLOBBER();
+    }
+}
+
+static void run_format_int_array(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        format_int_array(sc->array, sc->size, ',', sc->text, sc->text_capacity, &sc->text_length);
+        BENCH_CLOBBER();
+    }
+}
+
+static void run_parse_int_array(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    size_t count = 0;
+    size_t error_offset = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        parse_int_array(sc->text, sc->text_length, sc->work, sc->size, &count, &error_offset);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(count);
+}
+
+static void run_write_file(size_t iterations, void* ctx) {
+    ScalingContext* sc = (ScalingContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        BENCH_KEEP_INT(write_file_content(SCALING_FILE, sc->text, sc->size));
+    }
+}
+
+static void run_read_file(size_t iterations, void* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        char* content = NULL;
+        size_t size = 0;
+        if (read_file_content(SCALING_FILE, &content, &size) == STATUS_SUCCESS) {
+            BENCH_KEEP_INT(size);
+            free(content);
+        }
+    }
+}
+
+static const ScalingCase scaling_cases[] = {
+    {"array_operations", 2, 8, setup_array, run_array_operations},
+    {"sort_array", 2, 8, setup_array, run_sort_array},
+    {"scan_find_equal", 1, 8, setup_array, run_scan_find_equal},
+    {"process_array_batched", 1, 8, setup_array, run_process_array_batched},
+    {"add_node (build list)", 1, LIST_NODE_BYTES, setup_list, run_list_build},
+    {"find_node (tail)", 1, LIST_NODE_BYTES, setup_list, run_find_node},
+    {"string_operations", 1, 2, setup_text, run_string_operations},
+    {"format_int_array", 1, 24, setup_int_text, run_format_int_array},
+    {"parse_int_array", 1, 24, setup_int_text, run_parse_int_array},
+    {"write_file_content", 1, 2, setup_file, run_write_file},
+    {"read_file_content", 1, 3, setup_file, run_read_file},
+};
+
+#define SCALING_CASE_COUNT (sizeof(scaling_cases) / sizeof(scaling_cases[0]))
+
+// 吞吐量（百万元素/秒），0表示跳过
+static double scaling_throughput[SCALING_CASE_COUNT][SCALING_MAX_DECADES + 1];
+
+void bench_scaling_options_init(ScalingOptions* options) {
+    options->max_size = 100000000;
+    options->budget_seconds = 1.0;
+    options->max_memory_mb = 2048;
+}
+
+void bench_suite_scaling(BenchRunner* runner, const ScalingOptions* options) {
+    size_t sizes[SCALING_MAX_DECADES + 1];
+    size_t size_count = 0;
+    for (size_t n = 10; n <= options->max_size && size_count < SCALING_MAX_DECADES + 1; n *= 10) {
+        sizes[size_count++] = n;
+    }
+
+    bench_set_suite(runner, "scaling");
+    memset(scaling_throughput, 0, sizeof(scaling_throughput));
+
+    for (size_t c = 0; c < SCALING_CASE_COUNT; c++) {
+        const ScalingCase* sc_case = &scaling_cases[c];
+        double last_ns = 0.0;
+        size_t last_size = 0;
+
+        for (size_t s = 0; s < size_count; s++) {
+            size_t n = sizes[s];
+            char params[32];
+            snprintf(params, sizeof(params), "n=%zu", n);
+
+            double memory_mb = (double)n * (double)sc_case->bytes_per_element / (1024.0 * 1024.0);
+            if (memory_mb > (double)options->max_memory_mb) {
+                printf("%-12s %-28s %-16s skipped: needs ~%.0f MB (limit %zu MB)\n",
+                       "scaling", sc_case->name, params, memory_mb, options->max_memory_mb);
+                break;
+            }
+
+            if (last_size > 0) {
+                double predicted = last_ns * pow((double)n / (double)last_size, sc_case->complexity) * 1e-9;
+                if (predicted > options->budget_seconds) {
+                    printf("%-12s %-28s %-16s skipped: estimated %.2f s per call (budget %.2f s)\n",
+                           "scaling", sc_case->name, params, predicted, options->budget_seconds);
+                    break;
+                }
+            }
+
+            ScalingContext sc;
+            memset(&sc, 0, sizeof(sc));
+            sc.size = n;
+            if (sc_case->setup(&sc) != STATUS_SUCCESS) {
+                printf("%-12s %-28s %-16s skipped: setup failed\n", "scaling", sc_case->name, params);
+                scaling_context_free(&sc);
+                break;
+            }
+
+            const BenchResult* result = bench_run(runner, sc_case->name, params, sc_case->run, &sc);
+            scaling_context_free(&sc);
+            if (!result) {
+                break;
+            }
+
+            last_ns = result->median_ns;
+            last_size = n;
+            scaling_throughput[c][s] = (double)n * 1e3 / result->median_ns;
+        }
+    }
+    remove(SCALING_FILE);
+
+    printf("\nThroughput (million elements/s, '-' = skipped)\n%-24s", "function");
+    for (size_t s = 0; s < size_count; s++) {
+        char label[32];
+        snprintf(label, sizeof(label), "1e%zu", s + 1);
+        printf(" %9s", label);
+    }
+    printf("\n");
+    for (size_t c = 0; c < SCALING_CASE_COUNT; c++) {
+        printf("%-24s", scaling_cases[c].name);
+        for (size_t s = 0; s < size_count; s++) {
+            if (scaling_throughput[c][s] > 0.0) {
+                printf(" %9.2f", scaling_throughput[c][s]);
+            } else {
+                printf(" %9s", "-");
+            }
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+// ============================================================================
+// 线程数扩展测试
+// ============================================================================
+
+#define THREAD_SWEEP_MAX 64
+#define COUNTER_CALLS_PER_OP 65536            // 计数器用例每次操作的总调用次数
+
+typedef struct {
+    ThreadPool* pool;
+    int* array;
+    size_t size;
+    IntMatrix matrix;
+    char* src;
+    char* dest;
+    double* a;
+    double* b;
+    double* c;
+    ShardedCounter sum;
+    int (*counter_call)(void);        // 计数器用例在各线程上反复调用的函数
+} ThreadContext;
+
+static void sum_chunk_sharded(const int* chunk, size_t count, void* ctx) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += chunk[i];
+    }
+    sharded_counter_add((ShardedCounter*)ctx, sum);
+}
+
+static void run_process_array_parallel(size_t iterations, void* ctx) {
+    ThreadContext* tc = (ThreadContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        process_array_parallel(tc->pool, tc->array, tc->size, 64 * 1024, sum_chunk_sharded, &tc->sum);
+    }
+    BENCH_KEEP_INT(sharded_counter_read(&tc->sum));
+}
+
+static void run_matrix_reduce_parallel(size_t iterations, void* ctx) {
+    ThreadContext* tc = (ThreadContext*)ctx;
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int_matrix_fill_index_and_reduce_parallel(tc->pool, &tc->matrix, &sum);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void run_memory_copy_parallel(size_t iterations, void* ctx) {
+    ThreadContext* tc = (ThreadContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        memory_copy_parallel(tc->pool, tc->dest, tc->src, tc->size);
+        BENCH_CLOBBER();
+    }
+}
+
+static void run_gemm_parallel(size_t iterations, void* ctx) {
+    ThreadContext* tc = (ThreadContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        gemm_f64(tc->pool, tc->size, tc->size, tc->size, 1.0, tc->a, tc->size,
+                 tc->b, tc->size, 0.0, tc->c, tc->size);
+        BENCH_CLOBBER();
+    }
+}
+
+// 分片计数器函数：各线程同时调用，每次调用只应访问本线程分片的缓存行
+static int call_no_params_function(void) {
+    return no_params_function();
+}
+
+static int call_increment_global_counter(void) {
+    return (int)increment_global_counter();
+}
+
+static int call_get_static_value(void) {
+    return (int)get_static_value();
+}
+
+static void counter_calls_chunk(size_t begin, size_t end, size_t worker_index, void* ctx) {
+    (void)worker_index;
+    ThreadContext* tc = (ThreadContext*)ctx;
+    int64_t sum = 0;
+    for (size_t i = begin; i < end; i++) {
+        sum += tc->counter_call();
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void run_counter_calls(ThreadContext* tc, size_t iterations, int (*call)(void)) {
+    tc->counter_call = call;
+    for (size_t i = 0; i < iterations; i++) {
+        thread_pool_parallel_for(tc->pool, COUNTER_CALLS_PER_OP, 4096, counter_calls_chunk, tc);
+    }
+}
+
+static void run_no_params_parallel(size_t iterations, void* ctx) {
+    run_counter_calls((ThreadContext*)ctx, iterations, call_no_params_function);
+}
+
+static void run_increment_global_counter_parallel(size_t iterations, void* ctx) {
+    run_counter_calls((ThreadContext*)ctx, iterations, call_increment_global_counter);
+}
+
+static void run_get_static_value_parallel(size_t iterations, void* ctx) {
+    run_counter_calls((ThreadContext*)ctx, iterations, call_get_static_value);
+}
+
+typedef struct {
+    const char* name;
+    const char* unit;                 // 吞吐量单位
+    double work;                      // 每次操作的工作量（以unit计）
+    size_t size;                      // 写入ThreadContext.size的规模
+    BenchFunc run;
+} ThreadCase;
+
+static void thread_sweep(BenchRunner* runner, ThreadContext* tc, const ThreadCase* cases, size_t case_count,
+                         const size_t* thread_counts, size_t thread_count_count) {
+    // throughput[c * thread_count_count + t]：第c个用例在第t个线程数下的吞吐量
+    double* throughput = (double*)calloc(case_count * thread_count_count, sizeof(double));
+    if (!throughput) {
+        fprintf(stderr, "threads: failed to allocate result table\n");
+        return;
+    }
+
+    for (size_t t = 0; t < thread_count_count; t++) {
+        tc->pool = thread_pool_create(thread_counts[t]);
+        if (!tc->pool) {
+            fprintf(stderr, "threads: failed to create pool with %zu threads\n", thread_counts[t]);
+            break;
+        }
+
+        char params[32];
+        snprintf(params, sizeof(params), "threads=%zu", thread_counts[t]);
+        for (size_t c = 0; c < case_count; c++) {
+            tc->size = cases[c].size;
+            const BenchResult* result = bench_run(runner, cases[c].name, params, cases[c].run, tc);
+            if (result) {
+                throughput[c * thread_count_count + t] = cases[c].work / (result->median_ns * 1e-9);
+            }
+        }
+
+        thread_pool_destroy(tc->pool);
+        tc->pool = NULL;
+    }
+
+    printf("\nThroughput by thread count (speedup vs 1 thread in parentheses)\n%-28s %-8s", "function", "unit");
+    for (size_t t = 0; t < thread_count_count; t++) {
+        char label[32];
+        snprintf(label, sizeof(label), "%zu T", thread_counts[t]);
+        printf(" %16s", label);
+    }
+    printf("\n");
+    for (size_t c = 0; c < case_count; c++) {
+        const double* row = throughput + c * thread_count_count;
+        printf("%-28s %-8s", cases[c].name, cases[c].unit);
+        for (size_t t = 0; t < thread_count_count; t++) {
+            if (row[t] > 0.0 && row[0] > 0.0) {
+                printf(" %9.2f (%4.2fx)", row[t], row[t] / row[0]);
+            } else {
+                printf(" %16s", "-");
+            }
+        }
+        printf("\n");
+    }
+    printf("\n");
+
+    free(throughput);
+}
+
+void bench_suite_threads(BenchRunner* runner, const ScalingOptions* options) {
+    ThreadPool* all = thread_pool_create(0);
+    if (!all) {
+        fprintf(stderr, "threads: failed to create thread pool\n");
+        return;
+    }
+    size_t max_threads = MIN(thread_pool_concurrency(all), (size_t)THREAD_SWEEP_MAX);
+    thread_pool_destroy(all);
+
+    // 1, 2, 4, ...直到全部CPU
+    size_t thread_counts[THREAD_SWEEP_MAX];
+    size_t thread_count_count = 0;
+    for (size_t t = 1; t < max_threads; t *= 2) {
+        thread_counts[thread_count_count++] = t;
+    }
+    thread_counts[thread_count_count++] = max_threads;
+
+    // 数组取10^7个int与max_size中较小者，矩阵和GEMM取固定规模
+    size_t array_size = MIN(options->max_size, (size_t)10000000);
+    size_t copy_bytes = MIN(options->max_size, (size_t)64 * 1024 * 1024);
+    size_t matrix_n = 2048;
+    size_t gemm_n = 512;
+
+    ThreadContext tc;
+    memset(&tc, 0, sizeof(tc));
+    tc.array = (int*)malloc(array_size * sizeof(int));
+    tc.src = (char*)malloc(copy_bytes);
+    tc.dest = (char*)malloc(copy_bytes);
+    tc.a = (double*)malloc(gemm_n * gemm_n * sizeof(double));
+    tc.b = (double*)malloc(gemm_n * gemm_n * sizeof(double));
+    tc.c = (double*)malloc(gemm_n * gemm_n * sizeof(double));
+    Status status = int_matrix_create(&tc.matrix, matrix_n, matrix_n);
+
+    if (tc.array && tc.src && tc.dest && tc.a && tc.b && tc.c && status == STATUS_SUCCESS) {
+        fill_random(tc.array, array_size, 1000);
+        memset(tc.src, 0x5A, copy_bytes);
+        memset(tc.dest, 0, copy_bytes);
+        for (size_t i = 0; i < gemm_n * gemm_n; i++) {
+            tc.a[i] = (double)(i % 7) * 0.5;
+            tc.b[i] = (double)(i % 5) * 0.25;
+        }
+        sharded_counter_init(&tc.sum, 0);
+
+        const ThreadCase cases[] = {
+            {"process_array_parallel", "M int/s", (double)array_size / 1e6, array_size,
+             run_process_array_parallel},
+            {"int_matrix_reduce_parallel", "M int/s", (double)(matrix_n * matrix_n) / 1e6, matrix_n,
+             run_matrix_reduce_parallel},
+            {"memory_copy_parallel", "GB/s", (double)copy_bytes / 1e9, copy_bytes,
+             run_memory_copy_parallel},
+            {"gemm_f64", "GFLOPS", 2.0 * (double)gemm_n * (double)gemm_n * (double)gemm_n / 1e9, gemm_n,
+             run_gemm_parallel},
+            {"no_params_function", "M call/s", COUNTER_CALLS_PER_OP / 1e6, 0, run_no_params_parallel},
+            {"increment_global_counter", "M call/s", COUNTER_CALLS_PER_OP / 1e6, 0,
+             run_increment_global_counter_parallel},
+            {"get_static_value", "M call/s", COUNTER_CALLS_PER_OP / 1e6, 0, run_get_static_value_parallel},
+        };
+
+        bench_set_suite(runner, "threads");
+        thread_sweep(runner, &tc, cases, sizeof(cases) / sizeof(cases[0]), thread_counts, thread_count_count);
+    } else {
+        fprintf(stderr, "threads: failed to allocate buffers\n");
+    }
+
+    free(tc.array);
+    free(tc.src);
+    free(tc.dest);
+    free(tc.a);
+    free(tc.b);
+    free(tc.c);
+    int_matrix_destroy(&tc.matrix);
+}
@@ -0,0 +1,1081 @@
+#include "bench_suites.h"
+
+// 参数都从循环变量派生并把返回值写入sink，避免调用被常量折叠或整体删除
+
+// 标量参数的函数：v由循环变量派生，每次调用的结果转换为sum_type后累加，最后写入sink
+#define BENCH_SCALAR_CALL(bench_name, sum_type, keep, call)       \
+    static void bench_name(size_t iterations, void* ctx) {         \
+        (void)ctx;                                                 \
+        sum_type sum = 0;                                          \
+        for (size_t i = 0; i < iterations; i++) {                  \
+            int v = (int)(i & 0xFFFF);                             \
+            sum += (sum_type)(call);                               \
+        }                                                          \
+        keep(sum);                                                 \
+    }
+
+// 回调函数参数：结果累加到这里，基准函数结束时写入sink
+static int64_t bench_callback_sum;
+
+static int bench_square(int x) {
+    return x * x;
+}
+
+static int bench_add(int a, int b) {
+    return a + b;
+}
+
+static void bench_callback(int value) {
+    bench_callback_sum += value;
+}
+
+static void bench_callback_3(int a, float b, char c) {
+    bench_callback_sum += a + (int64_t)b + c;
+}
+
+// ============================================================================
+// 参数传递
+// ============================================================================
+
+static void bench_no_params(size_t iterations, void* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        no_params_function();
+        BENCH_CLOBBER();
+    }
+}
+
+static void bench_void_no_params(size_t iterations, void* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        void_no_params_function();
+        BENCH_CLOBBER();
+    }
+}
+
+BENCH_SCALAR_CALL(bench_single_int, int64_t, BENCH_KEEP_INT, single_int_param(v))
+BENCH_SCALAR_CALL(bench_single_float, double, BENCH_KEEP_DOUBLE, single_float_param((float)v))
+BENCH_SCALAR_CALL(bench_single_double, double, BENCH_KEEP_DOUBLE, single_double_param((double)v))
+BENCH_SCALAR_CALL(bench_single_char, int64_t, BENCH_KEEP_INT, single_char_param((char)v))
+BENCH_SCALAR_CALL(bench_single_bool, int64_t, BENCH_KEEP_INT, single_bool_param(v & 1))
+BENCH_SCALAR_CALL(bench_two_int, int64_t, BENCH_KEEP_INT, two_int_params(v, v + 1))
+BENCH_SCALAR_CALL(bench_two_float, double, BENCH_KEEP_DOUBLE, two_float_params((float)v, 1.5f))
+BENCH_SCALAR_CALL(bench_two_double, double, BENCH_KEEP_DOUBLE, two_double_params((double)v, 3.0))
+BENCH_SCALAR_CALL(bench_int_float, int64_t, BENCH_KEEP_INT, int_float_params(v, (float)v))
+BENCH_SCALAR_CALL(bench_float_double, double, BENCH_KEEP_DOUBLE, float_double_params((float)v, (double)v))
+BENCH_SCALAR_CALL(bench_int_char, int64_t, BENCH_KEEP_INT, int_char_params(v, (char)v))
+BENCH_SCALAR_CALL(bench_int_double, double, BENCH_KEEP_DOUBLE, int_double_params(v, 0.5))
+BENCH_SCALAR_CALL(bench_three_mixed_1, int64_t, BENCH_KEEP_INT, three_mixed_params_1(v, (float)v, (char)v))
+BENCH_SCALAR_CALL(bench_three_mixed_2, double, BENCH_KEEP_DOUBLE, three_mixed_params_2((double)v, v, v & 1))
+BENCH_SCALAR_CALL(bench_three_mixed_3, int64_t, BENCH_KEEP_INT, three_mixed_params_3((char)v, v, (float)v))
+BENCH_SCALAR_CALL(bench_four_mixed_1, int64_t, BENCH_KEEP_INT,
+                  four_mixed_params_1(v, (float)v, (double)v, (char)v))
+BENCH_SCALAR_CALL(bench_four_mixed_2, double, BENCH_KEEP_DOUBLE,
+                  four_mixed_params_2((char)v, v, (float)v, v & 1))
+BENCH_SCALAR_CALL(bench_four_mixed_3, int64_t, BENCH_KEEP_INT,
+                  four_mixed_params_3(v & 1, (double)v, v, (char)v))
+BENCH_SCALAR_CALL(bench_five_mixed_1, int64_t, BENCH_KEEP_INT,
+                  five_mixed_params_1(v, (float)v, (double)v, (char)v, v & 1))
+BENCH_SCALAR_CALL(bench_five_mixed_2, double, BENCH_KEEP_DOUBLE,
+                  five_mixed_params_2(v & 1, (char)v, v, (double)v, (float)v))
+BENCH_SCALAR_CALL(bench_six_mixed_1, int64_t, BENCH_KEEP_INT,
+                  six_mixed_params_1(v, (float)v, (double)v, (char)v, v & 1, (short)v))
+BENCH_SCALAR_CALL(bench_six_mixed_2, double, BENCH_KEEP_DOUBLE,
+                  six_mixed_params_2((short)v, v & 1, (char)v, (double)v, (float)v, v))
+BENCH_SCALAR_CALL(bench_seven_mixed, int64_t, BENCH_KEEP_INT,
+                  seven_mixed_params(v, (float)v, (double)v, (char)v, v & 1, (short)v, (long)v))
+BENCH_SCALAR_CALL(bench_eight_mixed, double, BENCH_KEEP_DOUBLE,
+                  eight_mixed_params(v, (float)v, (double)v, (char)v, v & 1, (short)v, (long)v, (unsigned int)v))
+BENCH_SCALAR_CALL(bench_many_float, double, BENCH_KEEP_DOUBLE,
+                  many_float_params((float)v, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, (float)v))
+BENCH_SCALAR_CALL(bench_many_double, double, BENCH_KEEP_DOUBLE,
+                  many_double_params((double)v, 1.0, 2.0, 3.0, 4.0, (double)v))
+BENCH_SCALAR_CALL(bench_function_pointer_1, int64_t, BENCH_KEEP_INT,
+                  function_pointer_param_1((v & 1) ? bench_square : single_int_param))
+BENCH_SCALAR_CALL(bench_function_pointer_2, int64_t, BENCH_KEEP_INT,
+                  function_pointer_param_2(bench_add, v, v + 1))
+BENCH_SCALAR_CALL(bench_recursive_param_1, int64_t, BENCH_KEEP_INT, recursive_param_test_1(100, v))
+BENCH_SCALAR_CALL(bench_recursive_param_2, double, BENCH_KEEP_DOUBLE,
+                  recursive_param_test_2(1.0001, 100, (double)v))
+
+static void bench_single_pointer(size_t iterations, void* ctx) {
+    (void)ctx;
+    int values[4] = {0, 0, 0, 0};
+    void* ptr = values;
+    for (size_t i = 0; i < iterations; i++) {
+        ptr = single_pointer_param(values + (i & 1));
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_POINTER(ptr);
+}
+
+static void bench_array_param_1(size_t iterations, void* ctx) {
+    (void)ctx;
+    int array[2] = {0, 1};
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        array[0] = (int)i;
+        sum += array_param_1(array);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_array_param_2(size_t iterations, void* ctx) {
+    (void)ctx;
+    int array[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        array[i % 10] = (int)i;
+        sum += array_param_2(array);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_array_param_3(size_t iterations, void* ctx) {
+    (void)ctx;
+    int array[64] = {0};
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        array[i % 64] = (int)i;
+        sum += array_param_3(array, 64);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_multidim_array(size_t iterations, void* ctx) {
+    (void)ctx;
+    int matrix[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        matrix[i % 3][(i / 3) % 3] = (int)i;
+        sum += multidim_array_param(matrix);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_callback_multiple(size_t iterations, void* ctx) {
+    (void)ctx;
+    bench_callback_sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int v = (int)(i & 0xFFFF);
+        callback_with_multiple_params(bench_callback_3, v, (float)v, (char)v);
+    }
+    BENCH_KEEP_INT(bench_callback_sum);
+}
+
+static void bench_complex_mixed_1(size_t iterations, void* ctx) {
+    (void)ctx;
+    float values[8] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int v = (int)(i & 0xFFFF);
+        Point p = {v, v + 1};
+        sum += complex_mixed_params_1(v, p, values, 8, (i & 1) != 0);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_complex_mixed_2(size_t iterations, void* ctx) {
+    (void)ctx;
+    char text[] = "complex_mixed_params_2";
+    double sum = 0.0;
+    for (size_t i = 0; i < iterations; i++) {
+        int v = (int)(i & 0xFFFF);
+        Rectangle r = {{v, v}, {v + 10, v + 10}, COLOR_BLUE};
+        sum += complex_mixed_params_2(&r, bench_square, (double)v, text);
+    }
+    BENCH_KEEP_DOUBLE(sum);
+}
+
+static void bench_complex_mixed_3(size_t iterations, void* ctx) {
+    (void)ctx;
+    Person person = create_person("Benchmark", 30, 1.75f, 70.0);
+    int results[3] = {0};
+    VariantData data;
+    memset(&data, 0, sizeof(data));
+    data.type = TYPE_INT;
+    bench_callback_sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        person.age = (int)(i & 0x3F);
+        data.value.i = 0;
+        complex_mixed_params_3(person, results, bench_callback, &data);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(bench_callback_sum + data.value.i + results[0]);
+}
+
+static void bench_many_int_params(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int v = (int)i;
+        sum += many_int_params(v, v + 1, v + 2, v + 3, v + 4, v + 5, v + 6, v + 7, v + 8, v + 9);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_param_passing_1(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int v = (int)i;
+        sum += param_passing_benchmark_1(v, v + 1, v + 2, v + 3, v + 4, v + 5, v + 6, v + 7, v + 8, v + 9);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_param_passing_2(size_t iterations, void* ctx) {
+    (void)ctx;
+    double sum = 0.0;
+    for (size_t i = 0; i < iterations; i++) {
+        double v = (double)i;
+        sum += param_passing_benchmark_2(v, v + 0.5, v + 1.0, v + 1.5, v + 2.0, v + 2.5, v + 3.0, v + 3.5);
+    }
+    BENCH_KEEP_DOUBLE(sum);
+}
+
+static void bench_param_passing_3(size_t iterations, void* ctx) {
+    (void)ctx;
+    int failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int v = (int)(i & 0xFFFF);
+        Point p = {v, v + 1};
+        Rectangle r = {{v, v}, {v + 10, v + 10}, COLOR_RED};
+        failures += param_passing_benchmark_3(p, p, p, p, r, r) != STATUS_SUCCESS;
+    }
+    BENCH_KEEP_INT(failures);
+}
+
+static void bench_struct_by_value(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        Point p = {(int)i, (int)i + 1};
+        sum += struct_by_value_param(p).x;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_struct_by_pointer(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        Point p = {(int)i, (int)i + 1};
+        sum += struct_by_pointer_param(&p).x;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_large_struct_by_value(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        Rectangle r = {{(int)i, 0}, {(int)i + 10, 10}, COLOR_GREEN};
+        sum += large_struct_by_value(r).bottom_right.x;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_large_struct_by_pointer(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        Rectangle r = {{(int)i, 0}, {(int)i + 10, 10}, COLOR_GREEN};
+        sum += large_struct_by_pointer(&r).bottom_right.x;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+void bench_suite_calls(BenchRunner* runner) {
+    bench_set_suite(runner, "calls");
+    bench_run(runner, "no_params_function", "", bench_no_params, NULL);
+    bench_run(runner, "void_no_params_function", "", bench_void_no_params, NULL);
+    bench_run(runner, "single_int_param", "", bench_single_int, NULL);
+    bench_run(runner, "single_float_param", "", bench_single_float, NULL);
+    bench_run(runner, "single_double_param", "", bench_single_double, NULL);
+    bench_run(runner, "single_char_param", "", bench_single_char, NULL);
+    bench_run(runner, "single_bool_param", "", bench_single_bool, NULL);
+    bench_run(runner, "single_pointer_param", "", bench_single_pointer, NULL);
+    bench_run(runner, "two_int_params", "", bench_two_int, NULL);
+    bench_run(runner, "two_float_params", "", bench_two_float, NULL);
+    bench_run(runner, "two_double_params", "", bench_two_double, NULL);
+    bench_run(runner, "int_float_params", "", bench_int_float, NULL);
+    bench_run(runner, "float_double_params", "", bench_float_double, NULL);
+    bench_run(runner, "int_char_params", "", bench_int_char, NULL);
+    bench_run(runner, "int_double_params", "", bench_int_double, NULL);
+    bench_run(runner, "three_mixed_params_1", "", bench_three_mixed_1, NULL);
+    bench_run(runner, "three_mixed_params_2", "", bench_three_mixed_2, NULL);
+    bench_run(runner, "three_mixed_params_3", "", bench_three_mixed_3, NULL);
+    bench_run(runner, "four_mixed_params_1", "", bench_four_mixed_1, NULL);
+    bench_run(runner, "four_mixed_params_2", "", bench_four_mixed_2, NULL);
+    bench_run(runner, "four_mixed_params_3", "", bench_four_mixed_3, NULL);
+    bench_run(runner, "five_mixed_params_1", "", bench_five_mixed_1, NULL);
+    bench_run(runner, "five_mixed_params_2", "", bench_five_mixed_2, NULL);
+    bench_run(runner, "six_mixed_params_1", "", bench_six_mixed_1, NULL);
+    bench_run(runner, "six_mixed_params_2", "", bench_six_mixed_2, NULL);
+    bench_run(runner, "seven_mixed_params", "", bench_seven_mixed, NULL);
+    bench_run(runner, "eight_mixed_params", "", bench_eight_mixed, NULL);
+    bench_run(runner, "many_int_params", "10 ints", bench_many_int_params, NULL);
+    bench_run(runner, "many_float_params", "8 floats", bench_many_float, NULL);
+    bench_run(runner, "many_double_params", "6 doubles", bench_many_double, NULL);
+    bench_run(runner, "param_passing_benchmark_1", "10 ints", bench_param_passing_1, NULL);
+    bench_run(runner, "param_passing_benchmark_2", "8 doubles", bench_param_passing_2, NULL);
+    bench_run(runner, "param_passing_benchmark_3", "4 Point+2 Rect", bench_param_passing_3, NULL);
+    bench_run(runner, "struct_by_value_param", "Point", bench_struct_by_value, NULL);
+    bench_run(runner, "struct_by_pointer_param", "Point", bench_struct_by_pointer, NULL);
+    bench_run(runner, "large_struct_by_value", "Rectangle", bench_large_struct_by_value, NULL);
+    bench_run(runner, "large_struct_by_pointer", "Rectangle", bench_large_struct_by_pointer, NULL);
+    bench_run(runner, "array_param_1", "int[]", bench_array_param_1, NULL);
+    bench_run(runner, "array_param_2", "int[10]", bench_array_param_2, NULL);
+    bench_run(runner, "array_param_3", "n=64", bench_array_param_3, NULL);
+    bench_run(runner, "multidim_array_param", "int[3][3]", bench_multidim_array, NULL);
+    bench_run(runner, "function_pointer_param_1", "", bench_function_pointer_1, NULL);
+    bench_run(runner, "function_pointer_param_2", "", bench_function_pointer_2, NULL);
+    bench_run(runner, "callback_with_multiple_params", "", bench_callback_multiple, NULL);
+    bench_run(runner, "complex_mixed_params_1", "", bench_complex_mixed_1, NULL);
+    bench_run(runner, "complex_mixed_params_2", "", bench_complex_mixed_2, NULL);
+    bench_run(runner, "complex_mixed_params_3", "Person by value", bench_complex_mixed_3, NULL);
+    bench_run(runner, "recursive_param_test_1", "n=100", bench_recursive_param_1, NULL);
+    bench_run(runner, "recursive_param_test_2", "exp=100", bench_recursive_param_2, NULL);
+}
+
+// ============================================================================
+// 数学运算
+// ============================================================================
+
+static void bench_add_integers(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        sum = add_integers(sum, (int)i);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+BENCH_SCALAR_CALL(bench_add_floats, double, BENCH_KEEP_DOUBLE, add_floats((float)v, 0.25f))
+BENCH_SCALAR_CALL(bench_add_doubles, double, BENCH_KEEP_DOUBLE, add_doubles((double)v, 0.25))
+BENCH_SCALAR_CALL(bench_subtract_integers, int64_t, BENCH_KEEP_INT, subtract_integers(v, 7))
+BENCH_SCALAR_CALL(bench_multiply_integers, int64_t, BENCH_KEEP_INT, multiply_integers(v, v + 1))
+BENCH_SCALAR_CALL(bench_modulo_operation, int64_t, BENCH_KEEP_INT, modulo_operation(v, 7 + (v & 3)))
+BENCH_SCALAR_CALL(bench_bitwise_and, unsigned int, BENCH_KEEP_INT, bitwise_and((unsigned int)v, 0x5A5Au))
+BENCH_SCALAR_CALL(bench_bitwise_or, unsigned int, BENCH_KEEP_INT, bitwise_or((unsigned int)v, 0x5A5Au))
+BENCH_SCALAR_CALL(bench_bitwise_xor, unsigned int, BENCH_KEEP_INT, bitwise_xor((unsigned int)v, 0x5A5Au))
+BENCH_SCALAR_CALL(bench_bitwise_not, unsigned int, BENCH_KEEP_INT, bitwise_not((unsigned int)v))
+BENCH_SCALAR_CALL(bench_left_shift, unsigned int, BENCH_KEEP_INT, left_shift((unsigned int)v, v & 31))
+BENCH_SCALAR_CALL(bench_right_shift, unsigned int, BENCH_KEEP_INT, right_shift((unsigned int)v, v & 31))
+BENCH_SCALAR_CALL(bench_inline_max, int64_t, BENCH_KEEP_INT, inline_max(v, 0x8000 - v))
+BENCH_SCALAR_CALL(bench_is_even, int64_t, BENCH_KEEP_INT, is_even(v))
+
+static void bench_divide_floats(size_t iterations, void* ctx) {
+    (void)ctx;
+    float sum = 0.0f;
+    for (size_t i = 0; i < iterations; i++) {
+        sum += divide_floats((float)i, 3.0f);
+    }
+    BENCH_KEEP_DOUBLE(sum);
+}
+
+static void bench_power_operation(size_t iterations, void* ctx) {
+    int exponent = *(const int*)ctx;
+    double sum = 0.0;
+    for (size_t i = 0; i < iterations; i++) {
+        sum += power_operation(1.0 + (double)(i & 0xFF) * 1e-6, exponent);
+    }
+    BENCH_KEEP_DOUBLE(sum);
+}
+
+static void bench_gcd_recursive(size_t iterations, void* ctx) {
+    (void)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        sum += gcd_recursive(1071 + (int)(i & 0xFF), 462);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_factorial_recursive(size_t iterations, void* ctx) {
+    int n = *(const int*)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        sum += factorial_recursive(n);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_fibonacci_recursive(size_t iterations, void* ctx) {
+    int n = *(const int*)ctx;
+    int sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        sum += fibonacci_recursive(n);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+void bench_suite_math(BenchRunner* runner) {
+    static const int power_exponent = 20;
+    static const int factorial_n = 12;
+    static const int fibonacci_n = 20;
+
+    bench_set_suite(runner, "math");
+    bench_run(runner, "add_integers", "", bench_add_integers, NULL);
+    bench_run(runner, "add_floats", "", bench_add_floats, NULL);
+    bench_run(runner, "add_doubles", "", bench_add_doubles, NULL);
+    bench_run(runner, "subtract_integers", "", bench_subtract_integers, NULL);
+    bench_run(runner, "multiply_integers", "", bench_multiply_integers, NULL);
+    bench_run(runner, "divide_floats", "", bench_divide_floats, NULL);
+    bench_run(runner, "modulo_operation", "", bench_modulo_operation, NULL);
+    bench_run(runner, "power_operation", "exp=20", bench_power_operation, (void*)&power_exponent);
+    bench_run(runner, "gcd_recursive", "", bench_gcd_recursive, NULL);
+    bench_run(runner, "factorial_recursive", "n=12", bench_factorial_recursive, (void*)&factorial_n);
+    bench_run(runner, "fibonacci_recursive", "n=20", bench_fibonacci_recursive, (void*)&fibonacci_n);
+    bench_run(runner, "bitwise_and", "", bench_bitwise_and, NULL);
+    bench_run(runner, "bitwise_or", "", bench_bitwise_or, NULL);
+    bench_run(runner, "bitwise_xor", "", bench_bitwise_xor, NULL);
+    bench_run(runner, "bitwise_not", "", bench_bitwise_not, NULL);
+    bench_run(runner, "left_shift", "", bench_left_shift, NULL);
+    bench_run(runner, "right_shift", "", bench_right_shift, NULL);
+    bench_run(runner, "inline_max", "header inline", bench_inline_max, NULL);
+    bench_run(runner, "is_even", "header inline", bench_is_even, NULL);
+}
+
+// ============================================================================
+// 排序和数组
+// ============================================================================
+
+typedef struct {
+    int* source;     // 打乱的原始数据，每次操作前复制到work
+    int* work;
+    size_t size;
+} SortContext;
+
+static Status sort_context_init(SortContext* sc, size_t size) {
+    sc->source = (int*)malloc(size * sizeof(int));
+    sc->work = (int*)malloc(size * sizeof(int));
+    sc->size = size;
+    if (!sc->source || !sc->work) {
+        free(sc->source);
+        free(sc->work);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    uint32_t state = 2463534242u;
+    for (size_t i = 0; i < size; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        sc->source[i] = (int)(state % 100000);
+    }
+    return STATUS_SUCCESS;
+}
+
+static void sort_context_free(SortContext* sc) {
+    free(sc->source);
+    free(sc->work);
+}
+
+// 每次操作包含一次size个int的memcpy，相对O(n^2)的排序可以忽略
+static void bench_sort_array(size_t iterations, void* ctx) {
+    SortContext* sc = (SortContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        memcpy(sc->work, sc->source, sc->size * sizeof(int));
+        sort_array(sc->work, sc->size, NULL);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(sc->work[sc->size / 2]);
+}
+
+static void bench_array_operations(size_t iterations, void* ctx) {
+    SortContext* sc = (SortContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        array_operations(sc->work, sc->size);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(sc->work[sc->size / 2]);
+}
+
+static void bench_scan_find_equal(size_t iterations, void* ctx) {
+    SortContext* sc = (SortContext*)ctx;
+    size_t found = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        // source中的值都小于100000，目标不存在，每次扫描整个数组
+        found += scan_find_equal(sc->source, sc->size, -1 - (int)(i & 1));
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(found);
+}
+
+static void bench_process_array(size_t iterations, void* ctx) {
+    SortContext* sc = (SortContext*)ctx;
+    bench_callback_sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        process_array(sc->source, sc->size, bench_callback);
+    }
+    BENCH_KEEP_INT(bench_callback_sum);
+}
+
+static Status bench_sum_processor(void* data, size_t size) {
+    const int* values = (const int*)data;
+    int64_t sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        sum += values[i];
+    }
+    bench_callback_sum += sum;
+    return STATUS_SUCCESS;
+}
+
+static void bench_generic_processor(size_t iterations, void* ctx) {
+    SortContext* sc = (SortContext*)ctx;
+    bench_callback_sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        generic_processor(sc->source, sc->size, bench_sum_processor);
+    }
+    BENCH_KEEP_INT(bench_callback_sum);
+}
+
+// work中是0, 2, 4, ...的有序序列（array_operations的结果），交替查找存在和不存在的值
+static void bench_binary_search(size_t iterations, void* ctx) {
+    SortContext* sc = (SortContext*)ctx;
+    int found = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int index = -1;
+        int target = (int)(i % (2 * sc->size));
+        found += binary_search_recursive(sc->work, target, 0, (int)sc->size - 1, &index) == STATUS_SUCCESS;
+    }
+    BENCH_KEEP_INT(found);
+}
+
+void bench_suite_sort(BenchRunner* runner) {
+    static const size_t sizes[] = {64, 512};
+
+    bench_set_suite(runner, "sort");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        SortContext sc;
+        if (sort_context_init(&sc, sizes[s]) != STATUS_SUCCESS) {
+            fprintf(stderr, "sort: failed to allocate %zu elements\n", sizes[s]);
+            return;
+        }
+
+        char params[32];
+        snprintf(params, sizeof(params), "n=%zu", sizes[s]);
+        bench_run(runner, "sort_array", params, bench_sort_array, &sc);
+        bench_run(runner, "array_operations", params, bench_array_operations, &sc);
+        bench_run(runner, "scan_find_equal", params, bench_scan_find_equal, &sc);
+        bench_run(runner, "process_array", params, bench_process_array, &sc);
+        bench_run(runner, "generic_processor", params, bench_generic_processor, &sc);
+        array_operations(sc.work, sc.size);
+        bench_run(runner, "binary_search_recursive", params, bench_binary_search, &sc);
+        sort_context_free(&sc);
+    }
+}
+
+// ============================================================================
+// 条件、循环和控制流
+// ============================================================================
+
+BENCH_SCALAR_CALL(bench_test_if, int64_t, BENCH_KEEP_INT, test_if_conditions((v % 200) - 50))
+BENCH_SCALAR_CALL(bench_test_switch, int64_t, BENCH_KEEP_INT, test_switch_statement((Color)(v & 7)))
+BENCH_SCALAR_CALL(bench_test_for, int64_t, BENCH_KEEP_INT, test_for_loop(v & 7, 100))
+BENCH_SCALAR_CALL(bench_test_while, int64_t, BENCH_KEEP_INT, test_while_loop(v & 7, 200))
+BENCH_SCALAR_CALL(bench_test_do_while, int64_t, BENCH_KEEP_INT, test_do_while_loop(50 + (v & 7)))
+BENCH_SCALAR_CALL(bench_nested_switch_if, int64_t, BENCH_KEEP_INT, nested_switch_if(v, v - 3, "+-*/"[v & 3]))
+BENCH_SCALAR_CALL(bench_sum_integers, int64_t, BENCH_KEEP_INT,
+                  sum_integers(8, v, v + 1, v + 2, v + 3, v + 4, v + 5, v + 6, v + 7))
+
+static void bench_complex_nested_loops(size_t iterations, void* ctx) {
+    (void)ctx;
+    int matrix[10][10];
+    int failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int rows = 8 + (int)(i & 1);
+        failures += complex_nested_loops(matrix, rows, 10) != STATUS_SUCCESS;
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(failures + matrix[5][5]);
+}
+
+// 数组中没有目标值也没有负数，每次都扫描整个数组
+static void bench_goto_example(size_t iterations, void* ctx) {
+    (void)ctx;
+    int array[256];
+    for (int i = 0; i < 256; i++) {
+        array[i] = i;
+    }
+    int failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        failures += goto_example(array, 256, 1000 + (int)(i & 1)) != STATUS_ERROR;
+    }
+    BENCH_KEEP_INT(failures);
+}
+
+void bench_suite_control(BenchRunner* runner) {
+    bench_set_suite(runner, "control");
+    bench_run(runner, "test_if_conditions", "", bench_test_if, NULL);
+    bench_run(runner, "test_switch_statement", "", bench_test_switch, NULL);
+    bench_run(runner, "test_for_loop", "", bench_test_for, NULL);
+    bench_run(runner, "test_while_loop", "", bench_test_while, NULL);
+    bench_run(runner, "test_do_while_loop", "", bench_test_do_while, NULL);
+    bench_run(runner, "nested_switch_if", "", bench_nested_switch_if, NULL);
+    bench_run(runner, "sum_integers", "8 varargs", bench_sum_integers, NULL);
+    bench_run(runner, "complex_nested_loops", "10x10", bench_complex_nested_loops, NULL);
+    bench_run(runner, "goto_example", "n=256", bench_goto_example, NULL);
+}
+
+// ============================================================================
+// 链表
+// ============================================================================
+
+typedef struct {
+    LinkedList* list;
+    size_t size;
+    uint32_t random_state;
+} ListContext;
+
+static void bench_list_build(size_t iterations, void* ctx) {
+    ListContext* lc = (ListContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        LinkedList* list = create_linked_list();
+        if (!list) {
+            return;
+        }
+        for (size_t n = 0; n < lc->size; n++) {
+            add_node(list, (int)n);
+        }
+        BENCH_KEEP_POINTER(list->tail);
+        destroy_linked_list(list);
+    }
+}
+
+static void bench_find_node(size_t iterations, void* ctx) {
+    ListContext* lc = (ListContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        // 交替查找中间和末尾的节点
+        int target = (i & 1) ? (int)(lc->size - 1) : (int)(lc->size / 2);
+        BENCH_KEEP_POINTER(find_node(lc->list, target));
+    }
+}
+
+static void bench_remove_add_node(size_t iterations, void* ctx) {
+    ListContext* lc = (ListContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        // 随机挑选要删除的值并追加回末尾，链表长度不变
+        // （固定步长会让下一轮的目标总在表头）
+        lc->random_state ^= lc->random_state << 13;
+        lc->random_state ^= lc->random_state >> 17;
+        lc->random_state ^= lc->random_state << 5;
+        int target = (int)(lc->random_state % lc->size);
+        remove_node(lc->list, target);
+        add_node(lc->list, target);
+    }
+    BENCH_KEEP_POINTER(lc->list->tail);
+}
+
+static void bench_recursive_param_3(size_t iterations, void* ctx) {
+    ListContext* lc = (ListContext*)ctx;
+    int max_depth = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        max_depth = 0;
+        recursive_param_test_3(lc->list->head, (int)(i & 1), &max_depth);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(max_depth);
+}
+
+static void bench_print_list(size_t iterations, void* ctx) {
+    ListContext* lc = (ListContext*)ctx;
+    int saved_fd = bench_stdout_silence();
+    for (size_t i = 0; i < iterations; i++) {
+        print_list(lc->list);
+    }
+    bench_stdout_restore(saved_fd);
+}
+
+void bench_suite_lists(BenchRunner* runner) {
+    static const size_t sizes[] = {16, 1024};
+
+    bench_set_suite(runner, "lists");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        ListContext lc = {create_linked_list(), sizes[s], 2463534242u};
+        if (!lc.list) {
+            fprintf(stderr, "lists: failed to create list\n");
+            return;
+        }
+        for (size_t n = 0; n < lc.size; n++) {
+            add_node(lc.list, (int)n);
+        }
+
+        char params[32];
+        snprintf(params, sizeof(params), "n=%zu", sizes[s]);
+        bench_run(runner, "add_node (build list)", params, bench_list_build, &lc);
+        bench_run(runner, "find_node", params, bench_find_node, &lc);
+        bench_run(runner, "remove_node+add_node", params, bench_remove_add_node, &lc);
+        bench_run(runner, "recursive_param_test_3", params, bench_recursive_param_3, &lc);
+        bench_run(runner, "print_list", params, bench_print_list, &lc);
+        destroy_linked_list(lc.list);
+    }
+}
+
+// ============================================================================
+// 结构体、指针、字符串和全局状态
+// ============================================================================
+
+static void bench_create_point(size_t iterations, void* ctx) {
+    (void)ctx;
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        Point p = create_point((int)i, (int)i + 1);
+        sum += p.x + p.y;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_create_rectangle(size_t iterations, void* ctx) {
+    (void)ctx;
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        Point top_left = {(int)i, 0};
+        Point bottom_right = {(int)i + 10, 10};
+        Rectangle r = create_rectangle(top_left, bottom_right, (Color)(i & 7));
+        sum += r.bottom_right.x + r.color;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_create_person(size_t iterations, void* ctx) {
+    (void)ctx;
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        Person person = create_person("Benchmark Person", (int)(i & 0x3F), 1.75f, 70.0);
+        sum += person.age + person.is_active + person.name[i & 7];
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_compare_persons(size_t iterations, void* ctx) {
+    (void)ctx;
+    Person a = create_person("Alice", 30, 1.65f, 55.0);
+    Person b = create_person("Bob", 30, 1.80f, 80.0);
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        b.age = 28 + (int)(i & 3);
+        sum += compare_persons(&a, &b);
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_pointer_arithmetic(size_t iterations, void* ctx) {
+    (void)ctx;
+    int array[32] = {0};
+    int failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        array[0] = (int)i;
+        failures += pointer_arithmetic(array, 1 + (i & 15)) != STATUS_SUCCESS;
+    }
+    BENCH_KEEP_INT(failures + array[16]);
+}
+
+static void bench_string_operations(size_t iterations, void* ctx) {
+    (void)ctx;
+    static const char* const sources[] = {
+        "short", "a medium length string", "string_operations copies and measures this text", "x"
+    };
+    char dest[64];
+    int failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        failures += string_operations(dest, sources[i & 3], sizeof(dest)) != STATUS_SUCCESS;
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(failures + dest[0]);
+}
+
+// 每次调用前重置值，避免整数反复翻倍溢出
+static void bench_variant_data(size_t iterations, void* ctx) {
+    (void)ctx;
+    VariantData data;
+    double sum = 0.0;
+    for (size_t i = 0; i < iterations; i++) {
+        data.type = (VariantType)(i & 3);
+        switch (data.type) {
+            case TYPE_INT:
+                data.value.i = (int)(i & 0xFFFF);
+                break;
+            case TYPE_FLOAT:
+                data.value.f = (float)(i & 0xFFFF);
+                break;
+            case TYPE_DOUBLE:
+                data.value.d = (double)(i & 0xFFFF);
+                break;
+            default:
+                memcpy(data.value.c, "variant", 8);
+                break;
+        }
+        variant_data_operations(&data);
+        sum += data.value.c[0];
+    }
+    BENCH_KEEP_DOUBLE(sum);
+}
+
+static void bench_bitfield_operations(size_t iterations, void* ctx) {
+    (void)ctx;
+    BitField bf;
+    memset(&bf, 0, sizeof(bf));
+    // 经volatile指针调用，防止LTO把整个位域操作常量折叠掉
+    BitField* volatile target = &bf;
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        bf.value = (unsigned int)(i & 0xFFFFFF);
+        bitfield_operations(target);
+        sum += bf.value + bf.flag3;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_union_operations(size_t iterations, void* ctx) {
+    (void)ctx;
+    DataUnion data;
+    memset(&data, 0, sizeof(data));
+    int saved_fd = bench_stdout_silence();
+    for (size_t i = 0; i < iterations; i++) {
+        data.d = (double)i;
+        union_operations(&data);
+    }
+    bench_stdout_restore(saved_fd);
+    BENCH_KEEP_INT(data.i);
+}
+
+static void bench_increment_global_counter(size_t iterations, void* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        increment_global_counter();
+        BENCH_CLOBBER();
+    }
+}
+
+BENCH_SCALAR_CALL(bench_get_static_value, int64_t, BENCH_KEEP_INT, get_static_value() + v)
+BENCH_SCALAR_CALL(bench_get_global_counter, int64_t, BENCH_KEEP_INT, get_global_counter() + v)
+
+void bench_suite_data(BenchRunner* runner) {
+    bench_set_suite(runner, "data");
+    bench_run(runner, "create_point", "", bench_create_point, NULL);
+    bench_run(runner, "create_rectangle", "", bench_create_rectangle, NULL);
+    bench_run(runner, "create_person", "", bench_create_person, NULL);
+    bench_run(runner, "compare_persons", "", bench_compare_persons, NULL);
+    bench_run(runner, "pointer_arithmetic", "", bench_pointer_arithmetic, NULL);
+    bench_run(runner, "string_operations", "<=48 chars", bench_string_operations, NULL);
+    bench_run(runner, "variant_data_operations", "4 types", bench_variant_data, NULL);
+    bench_run(runner, "bitfield_operations", "", bench_bitfield_operations, NULL);
+    bench_run(runner, "union_operations", "stdout->null", bench_union_operations, NULL);
+    bench_run(runner, "increment_global_counter", "", bench_increment_global_counter, NULL);
+    bench_run(runner, "get_static_value", "", bench_get_static_value, NULL);
+    bench_run(runner, "get_global_counter", "32 shards", bench_get_global_counter, NULL);
+}
+
+// ============================================================================
+// 内存管理
+// ============================================================================
+
+typedef struct {
+    char* src;
+    char* dest;
+    size_t size;
+} MemoryContext;
+
+static void bench_safe_malloc_free(size_t iterations, void* ctx) {
+    MemoryContext* mc = (MemoryContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        void* ptr = safe_malloc(mc->size);
+        BENCH_KEEP_POINTER(ptr);
+        safe_free(&ptr);
+    }
+}
+
+// 从16字节按2倍增长到size，再整体释放
+static void bench_safe_realloc(size_t iterations, void* ctx) {
+    MemoryContext* mc = (MemoryContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        void* ptr = NULL;
+        for (size_t size = 16; size <= mc->size; size *= 2) {
+            void* grown = safe_realloc(ptr, size);
+            if (!grown) {
+                break;
+            }
+            ptr = grown;
+        }
+        BENCH_KEEP_POINTER(ptr);
+        safe_free(&ptr);
+    }
+}
+
+static void bench_memory_copy(size_t iterations, void* ctx) {
+    MemoryContext* mc = (MemoryContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        memory_copy(mc->dest, mc->src, mc->size);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(mc->dest[mc->size / 2]);
+}
+
+static void bench_memory_set(size_t iterations, void* ctx) {
+    MemoryContext* mc = (MemoryContext*)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        memory_set(mc->dest, (int)(i & 0xFF), mc->size);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(mc->dest[mc->size / 2]);
+}
+
+void bench_suite_memory(BenchRunner* runner) {
+    static const size_t sizes[] = {64, 4096};
+
+    bench_set_suite(runner, "memory");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        MemoryContext mc = {(char*)malloc(sizes[s]), (char*)malloc(sizes[s]), sizes[s]};
+        if (!mc.src || !mc.dest) {
+            fprintf(stderr, "memory: failed to allocate %zu bytes\n", sizes[s]);
+            free(mc.src);
+            free(mc.dest);
+            return;
+        }
+        memset(mc.src, 0x5A, mc.size);
+
+        char params[32];
+        snprintf(params, sizeof(params), "%zu B", sizes[s]);
+        bench_run(runner, "safe_malloc+safe_free", params, bench_safe_malloc_free, &mc);
+        bench_run(runner, "safe_realloc growth", params, bench_safe_realloc, &mc);
+        bench_run(runner, "memory_copy", params, bench_memory_copy, &mc);
+        bench_run(runner, "memory_set", params, bench_memory_set, &mc);
+        free(mc.src);
+        free(mc.dest);
+    }
+}
+
+// ============================================================================
+// 文件和格式化
+// ============================================================================
+
+#define BENCH_IO_FILE "bench_io.tmp"
+
+typedef struct {
+    char* data;
+    size_t size;
+} IoContext;
+
+static void bench_write_file(size_t iterations, void* ctx) {
+    IoContext* io = (IoContext*)ctx;
+    int failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        failures += write_file_content(BENCH_IO_FILE, io->data, io->size) != STATUS_SUCCESS;
+    }
+    BENCH_KEEP_INT(failures);
+}
+
+static void bench_read_file(size_t iterations, void* ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < iterations; i++) {
+        char* content = NULL;
+        size_t size = 0;
+        if (read_file_content(BENCH_IO_FILE, &content, &size) == STATUS_SUCCESS) {
+            BENCH_KEEP_INT(content[size / 2]);
+            free(content);
+        }
+    }
+}
+
+// 每次采样前截断文件，文件大小只随单次采样的迭代次数增长
+static void bench_append_file(size_t iterations, void* ctx) {
+    (void)ctx;
+    remove(BENCH_IO_FILE);
+    int failures = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        failures += append_to_file(BENCH_IO_FILE, "append_to_file benchmark line\n") != STATUS_SUCCESS;
+    }
+    BENCH_KEEP_INT(failures);
+}
+
+static void bench_print_person(size_t iterations, void* ctx) {
+    (void)ctx;
+    Person person = create_person("Benchmark", 30, 1.75f, 70.0);
+    int saved_fd = bench_stdout_silence();
+    for (size_t i = 0; i < iterations; i++) {
+        person.age = (int)(i & 0x3F);
+        print_person(&person);
+    }
+    bench_stdout_restore(saved_fd);
+}
+
+static void bench_print_formatted(size_t iterations, void* ctx) {
+    (void)ctx;
+    int saved_fd = bench_stdout_silence();
+    for (size_t i = 0; i < iterations; i++) {
+        print_formatted("%s %d %.3f\n", "print_formatted", (int)i, (double)i * 0.5);
+    }
+    bench_stdout_restore(saved_fd);
+}
+
+static void bench_int_to_string(size_t iterations, void* ctx) {
+    (void)ctx;
+    char buffer[32];
+    for (size_t i = 0; i < iterations; i++) {
+        safe_int_to_string((int)(i * 2654435761u), buffer, sizeof(buffer));
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(buffer[0]);
+}
+
+static void bench_string_to_int(size_t iterations, void* ctx) {
+    (void)ctx;
+    static const char* const inputs[] = {"0", "42", "-17", "123456", "2147483647", "-2147483648", "12x", "99999"};
+    int64_t sum = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        int value = 0;
+        safe_string_to_int(inputs[i & 7], &value);
+        sum += value;
+    }
+    BENCH_KEEP_INT(sum);
+}
+
+static void bench_format_int_array(size_t iterations, void* ctx) {
+    IoContext* io = (IoContext*)ctx;
+    const int* values = (const int*)io->data;
+    size_t count = io->size / sizeof(int);
+    size_t length = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        format_int_array(values, count, ',', io->data + io->size, io->size * 3, &length);
+        BENCH_CLOBBER();
+    }
+    BENCH_KEEP_INT(length);
+}
+
+void bench_suite_io(BenchRunner* runner) {
+    static const size_t sizes[] = {4096, 256 * 1024};
+
+    bench_set_suite(runner, "io");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        // 前size字节是测试数据，后面留给format_int_array作输出缓冲区
+        IoContext io = {(char*)malloc(sizes[s] * 4), sizes[s]};
+        if (!io.data) {
+            fprintf(stderr, "io: failed to allocate %zu bytes\n", sizes[s]);
+            return;
+        }
+        for (size_t i = 0; i < io.size; i++) {
+            io.data[i] = (char)('a' + i % 26);
+        }
+
+        char params[32];
+        snprintf(params, sizeof(params), "%zu KB", sizes[s] / 1024);
+        bench_run(runner, "write_file_content", params, bench_write_file, &io);
+        bench_run(runner, "read_file_content", params, bench_read_file, &io);
+        if (s == 0) {
+            bench_run(runner, "append_to_file", "30 B", bench_append_file, NULL);
+            bench_run(runner, "safe_int_to_string", "", bench_int_to_string, NULL);
+            bench_run(runner, "safe_string_to_int", "", bench_string_to_int, NULL);
+            bench_run(runner, "print_person", "stdout->null", bench_print_person, NULL);
+            bench_run(runner, "print_formatted", "stdout->null", bench_print_formatted, NULL);
+        }
+        snprintf(params, sizeof(params), "%zu ints", io.size / sizeof(int));
+        bench_run(runner, "format_int_array", params, bench_format_int_array, &io);
+        free(io.data);
+    }
+    remove(BENCH_IO_FILE);
+}
@@ -0,0 +1,40 @@
+#ifndef BENCH_SUITES_H
+#define BENCH_SUITES_H
+
+#include "bench_harness.h"
+
+// ============================================================================
+// 基准测试套件
+// ============================================================================
+
+// 参数传递：寄存器/栈传参、结构体按值与按指针
+void bench_suite_calls(BenchRunner* runner);
+// 基础数学、位运算和递归函数
+void bench_suite_math(BenchRunner* runner);
+// 排序、数组处理和回调
+void bench_suite_sort(BenchRunner* runner);
+// 条件、循环、switch/goto和变参函数
+void bench_suite_control(BenchRunner* runner);
+// 链表增删查和遍历
+void bench_suite_lists(BenchRunner* runner);
+// 结构体、指针、字符串、位域/联合体和全局计数器
+void bench_suite_data(BenchRunner* runner);
+// safe_*分配函数和内存复制/设置
+void bench_suite_memory(BenchRunner* runner);
+// 文件读写、格式化和打印到标准输出的函数
+void bench_suite_io(BenchRunner* runner);
+
+// 规模扩展测试的限制
+typedef struct {
+    size_t max_size;              // 最大输入规模（元素个数）
+    double budget_seconds;        // 预测单次调用超过该时间的规模被跳过
+    size_t max_memory_mb;         // 预计内存占用超过该值的规模被跳过
+} ScalingOptions;
+
+void bench_scaling_options_init(ScalingOptions* options);
+// 输入规模从10到max_size按10倍递增，打印吞吐量曲线
+void bench_suite_scaling(BenchRunner* runner, const ScalingOptions* options);
+// 并行路径的线程数从1到全部CPU，打印吞吐量和加速比
+void bench_suite_threads(BenchRunner* runner, const ScalingOptions* options);
+
+#endif // BENCH_SUITES_H
@@ -0,0 +1,113 @@
+# 两阶段配置文件引导优化（PGO），由顶层CMakeLists.txt的pgo/pgo-compare目标以
+# cmake -P调用。
+#
+# MODE=build:
+#   1. 在PGO_BINARY_DIR中以-DUTILS_PGO=GENERATE配置Release构建并编译插桩版本
+#   2. 运行bench（参数WORKLOAD_ARGS）和main采集profile
+#   3. Clang下用llvm-profdata合并.profraw
+#   4. 在同一目录以-DUTILS_PGO=USE重新配置并构建，得到PGO优化后的bench/main
+# MODE=compare:
+#   用BASELINE_BENCH（当前构建）和PGO构建的bench各运行一次，输出bench --compare结果
+
+cmake_minimum_required(VERSION 3.9)
+
+foreach(var SOURCE_DIR PGO_BINARY_DIR GENERATOR C_COMPILER COMPILER_ID MODE)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "UtilsPGO.cmake: 缺少参数${var}")
+    endif()
+endforeach()
+
+set(PROFILE_DIR "${PGO_BINARY_DIR}/profiles")
+separate_arguments(WORKLOAD_ARGS UNIX_COMMAND "${WORKLOAD_ARGS}")
+
+# 单配置生成器输出到bin/，多配置生成器输出到bin/Release/
+function(pgo_find_program name result)
+    foreach(candidate "${PGO_BINARY_DIR}/bin/${name}" "${PGO_BINARY_DIR}/bin/Release/${name}")
+        if(EXISTS "${candidate}")
+            set(${result} "${candidate}" PARENT_SCOPE)
+            return()
+        endif()
+    endforeach()
+    message(FATAL_ERROR "在${PGO_BINARY_DIR}/bin中找不到${name}，请先构建pgo目标")
+endfunction()
+
+# 运行命令，失败时终止；第一个参数为QUIET时丢弃标准输出
+function(pgo_run)
+    set(command ${ARGN})
+    list(GET command 0 first)
+    if(first STREQUAL "QUIET")
+        list(REMOVE_AT command 0)
+        execute_process(COMMAND ${command} RESULT_VARIABLE status OUTPUT_QUIET)
+    else()
+        execute_process(COMMAND ${command} RESULT_VARIABLE status)
+    endif()
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "命令失败（${status}）: ${ARGN}")
+    endif()
+endfunction()
+
+function(pgo_configure_and_build stage)
+    message(STATUS "PGO: 配置并构建（UTILS_PGO=${stage}）")
+    # GENERATE和USE两个阶段共用同一个构建目录
+    file(MAKE_DIRECTORY "${PGO_BINARY_DIR}")
+    execute_process(COMMAND ${CMAKE_COMMAND} "${SOURCE_DIR}" -G "${GENERATOR}"
+                            -DCMAKE_C_COMPILER=${C_COMPILER}
+                            -DCMAKE_BUILD_TYPE=Release
+                            -DUTILS_BUILD_BENCHMARKS=ON
+                            -DUTILS_ENABLE_LTO=${ENABLE_LTO}
+                            -DUTILS_PGO=${stage}
+                            -DUTILS_PGO_DIR=${PROFILE_DIR}
+                    WORKING_DIRECTORY "${PGO_BINARY_DIR}"
+                    RESULT_VARIABLE status)
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "配置${PGO_BINARY_DIR}失败")
+    endif()
+    pgo_run(${CMAKE_COMMAND} --build "${PGO_BINARY_DIR}" --config Release --target bench)
+    pgo_run(${CMAKE_COMMAND} --build "${PGO_BINARY_DIR}" --config Release --target main)
+endfunction()
+
+if(MODE STREQUAL "build")
+    # 旧的profile与新的插桩代码不匹配，先清掉
+    file(REMOVE_RECURSE "${PROFILE_DIR}")
+    file(MAKE_DIRECTORY "${PROFILE_DIR}")
+
+    pgo_configure_and_build(GENERATE)
+
+    message(STATUS "PGO: 运行负载采集profile")
+    pgo_find_program(bench bench_program)
+    pgo_find_program(main main_program)
+    pgo_run(QUIET "${bench_program}" ${WORKLOAD_ARGS})
+    execute_process(COMMAND "${main_program}" OUTPUT_QUIET)
+
+    if(COMPILER_ID MATCHES "Clang")
+        if(NOT LLVM_PROFDATA)
+            message(FATAL_ERROR "Clang的PGO需要llvm-profdata，请安装或设置UTILS_LLVM_PROFDATA")
+        endif()
+        file(GLOB raw_profiles "${PROFILE_DIR}/*.profraw")
+        if(NOT raw_profiles)
+            message(FATAL_ERROR "负载没有生成任何.profraw文件")
+        endif()
+        pgo_run("${LLVM_PROFDATA}" merge -output=${PROFILE_DIR}/default.profdata ${raw_profiles})
+    endif()
+
+    pgo_configure_and_build(USE)
+    message(STATUS "PGO: 完成，优化后的程序在${PGO_BINARY_DIR}/bin")
+elseif(MODE STREQUAL "compare")
+    if(NOT BASELINE_BENCH)
+        message(FATAL_ERROR "UtilsPGO.cmake: compare模式需要BASELINE_BENCH")
+    endif()
+    pgo_find_program(bench pgo_bench)
+
+    set(baseline_json "${PGO_BINARY_DIR}/compare-baseline.json")
+    set(pgo_json "${PGO_BINARY_DIR}/compare-pgo.json")
+    message(STATUS "PGO: 运行当前构建的bench")
+    pgo_run(QUIET "${BASELINE_BENCH}" ${WORKLOAD_ARGS} --json "${baseline_json}")
+    message(STATUS "PGO: 运行PGO构建的bench")
+    pgo_run(QUIET "${pgo_bench}" ${WORKLOAD_ARGS} --json "${pgo_json}")
+
+    # 有回归时bench退出码为1，这里只展示结果，不让目标失败
+    execute_process(COMMAND "${pgo_bench}" --compare "${baseline_json}" "${pgo_json}")
+    message(STATUS "PGO: 只有当前构建也是Release时对比才有意义（结果文件中记录了构建配置）")
+else()
+    message(FATAL_ERROR "UtilsPGO.cmake: 未知MODE ${MODE}")
+endif()
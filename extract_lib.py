@@ -4,6 +4,8 @@
 Library Extraction Script for Assembly Reverse Engineering
 This script extracts .obj files from utils.lib and generates .asm files
 Also supports converting debug libraries to release libraries
+On Linux (GCC/Clang builds) it extracts .o files from libutils.a using ar,
+objdump/llvm-objdump and nm
 """
 
 import os
@@ -12,18 +14,23 @@ import subprocess
 import argparse
 import shutil
 import glob
+import hashlib
+import json
+import platform
 import tempfile
+from concurrent.futures import ThreadPoolExecutor, as_completed
 from pathlib import Path
 
-def run_command(cmd, cwd=None, capture_output=True):
-    """运行命令并返回结果"""
-    print(f"Running: {' '.join(cmd)}")
+def run_command(cmd, cwd=None, capture_output=True, echo=True):
+    """运行命令并返回结果，echo为False时不打印命令和捕获的输出"""
+    if echo:
+        print(f"Running: {' '.join(cmd)}")
     try:
         if capture_output:
             # 使用适当的编码处理Windows工具输出
             result = subprocess.run(cmd, cwd=cwd, check=True, capture_output=True, 
                                   text=True, encoding='utf-8', errors='ignore')
-            if result.stdout:
+            if result.stdout and echo:
                 print(result.stdout)
             return result
         else:
@@ -42,7 +49,7 @@ def run_command(cmd, cwd=None, capture_output=True):
         try:
             result = subprocess.run(cmd, cwd=cwd, check=True, capture_output=True, 
                                   text=True, encoding='cp1252', errors='ignore')
-            if result.stdout:
+            if result.stdout and echo:
                 print(result.stdout)
             return result
         except Exception as e2:
@@ -178,6 +185,153 @@ def find_editbin_tool():
     
     return None
 
+class GnuToolchain:
+    """GCC/Clang构建使用的binutils（或LLVM）工具集合"""
+
+    def __init__(self, ar, objdump, nm, syntax="intel"):
+        self.ar = ar
+        self.objdump = objdump
+        self.nm = nm
+        self.syntax = syntax
+
+    def is_llvm_objdump(self):
+        return "llvm-objdump" in os.path.basename(self.objdump)
+
+    def disassemble_command(self, obj_file):
+        """objdump -d -r --no-show-raw-insn，x86上按需使用Intel语法（与dumpbin一致）"""
+        cmd = [self.objdump, "-d", "-r", "--no-show-raw-insn", "-C"]
+        if self.syntax == "intel" and is_x86_host():
+            if self.is_llvm_objdump():
+                cmd.append("--x86-asm-syntax=intel")
+            else:
+                cmd.extend(["-M", "intel"])
+        cmd.append(obj_file)
+        return cmd
+
+def is_x86_host():
+    """当前主机是否为x86/x64"""
+    return platform.machine().lower() in ("x86_64", "amd64", "i386", "i686", "x86")
+
+def is_gnu_toolchain(tool):
+    return isinstance(tool, GnuToolchain)
+
+def find_first_program(names):
+    """在PATH中查找第一个存在的程序"""
+    for name in names:
+        path = shutil.which(name)
+        if path:
+            return path
+    return None
+
+def find_gnu_toolchain(syntax="intel"):
+    """查找ar、objdump和nm，找不到GNU binutils时使用LLVM对应的工具"""
+    ar = find_first_program(["ar", "llvm-ar"])
+    objdump = find_first_program(["objdump", "llvm-objdump"])
+    nm = find_first_program(["nm", "llvm-nm"])
+
+    missing = [name for name, path in (("ar", ar), ("objdump", objdump), ("nm", nm)) if not path]
+    if missing:
+        print(f"Error: {', '.join(missing)} not found. Please install binutils or LLVM.")
+        return None
+
+    print(f"Found ar: {ar}")
+    print(f"Found objdump: {objdump}")
+    print(f"Found nm: {nm}")
+    return GnuToolchain(ar, objdump, nm, syntax)
+
+def detect_toolchain(requested, lib_file=None):
+    """确定使用msvc还是gnu工具链：.a库或非Windows主机使用gnu"""
+    if requested != "auto":
+        return requested
+    if lib_file:
+        if lib_file.endswith(".a"):
+            return "gnu"
+        if lib_file.endswith(".lib"):
+            return "msvc"
+    return "msvc" if os.name == "nt" else "gnu"
+
+def default_lib_candidates(project_root, config, toolchain, allow_shared=True):
+    """按构建方式列出可能的库文件位置
+
+    MSVC多配置生成器输出到build/lib/<config>/utils.lib；GCC/Clang的多配置
+    生成器同样按配置分目录，单配置构建则通常使用build-<config>/或build/
+    """
+    if toolchain == "msvc":
+        return [os.path.join(project_root, "build", "lib", config, "utils.lib")]
+
+    candidates = [
+        os.path.join(project_root, "build", "lib", config, "libutils.a"),
+        os.path.join(project_root, f"build-{config.lower()}", "lib", "libutils.a"),
+    ]
+    if allow_shared:
+        # 单个构建目录不区分配置，Debug和Release共用
+        candidates.append(os.path.join(project_root, "build", "lib", "libutils.a"))
+    return candidates
+
+def find_default_lib(project_root, config, toolchain, allow_shared=True):
+    """返回第一个存在的库文件，都不存在时返回首选位置"""
+    candidates = default_lib_candidates(project_root, config, toolchain, allow_shared)
+    for candidate in candidates:
+        if os.path.exists(candidate):
+            return candidate
+    return candidates[0]
+
+def find_object_files(obj_dir):
+    """列出目录中的目标文件（MSVC为.obj，GCC/Clang为.o）"""
+    return sorted(glob.glob(os.path.join(obj_dir, "*.obj")) + glob.glob(os.path.join(obj_dir, "*.o")))
+
+def list_symbols(tool, file_path):
+    """列出库或目标文件中的符号（dumpbin /SYMBOLS或nm --defined-only）"""
+    symbols = []
+    if is_gnu_toolchain(tool):
+        result = run_command([tool.nm, "--defined-only", file_path], capture_output=True)
+        if result:
+            for line in result.stdout.split('\n'):
+                # 成员名行（"utils.c.o:"）和空行不是符号
+                if len(line.split()) == 3:
+                    symbols.append(line.strip())
+    else:
+        result = run_command([tool, "/SYMBOLS", file_path], capture_output=True)
+        if result:
+            for line in result.stdout.split('\n'):
+                line = line.strip()
+                if 'External' in line or 'Static' in line:
+                    symbols.append(line)
+    return symbols
+
+def extract_obj_files_gnu(lib_file, output_dir, toolchain):
+    """用ar从.a静态库中提取.o文件"""
+    list_cmd = [toolchain.ar, "t", lib_file]
+    result = run_command(list_cmd)
+
+    if not result:
+        print("Failed to list library contents")
+        return False
+
+    obj_files = [line.strip() for line in result.stdout.split('\n') if line.strip().endswith('.o')]
+    if not obj_files:
+        print("No .o files found in library")
+        return False
+
+    print(f"Found {len(obj_files)} .o files:")
+    for obj_file in obj_files:
+        print(f"  - {obj_file}")
+
+    # ar x把成员解压到当前目录，库路径需要是绝对路径
+    extract_cmd = [toolchain.ar, "x", os.path.abspath(lib_file)]
+    if run_command(extract_cmd, cwd=output_dir) is None:
+        print(f"Failed to extract objects from {lib_file}")
+        return False
+
+    for obj_file in obj_files:
+        if os.path.exists(os.path.join(output_dir, os.path.basename(obj_file))):
+            print(f"✓ Extracted: {os.path.basename(obj_file)}")
+        else:
+            print(f"Failed to extract {obj_file}")
+            return False
+
+    return True
+
 def extract_obj_files(lib_file, output_dir, lib_tool):
     """从静态库中提取.obj文件"""
     print(f"\n=== Extracting .obj files from {lib_file} ===")
@@ -185,6 +339,9 @@ def extract_obj_files(lib_file, output_dir, lib_tool):
     # 创建输出目录
     os.makedirs(output_dir, exist_ok=True)
     
+    if is_gnu_toolchain(lib_tool):
+        return extract_obj_files_gnu(lib_file, output_dir, lib_tool)
+    
     # 列出库中的文件
     list_cmd = [lib_tool, "/LIST", lib_file]
     result = run_command(list_cmd)
@@ -226,49 +383,136 @@ def extract_obj_files(lib_file, output_dir, lib_tool):
     
     return True
 
-def generate_asm_files(obj_dir, asm_dir, dumpbin_tool):
-    """从.obj文件生成.asm文件"""
-    print(f"\n=== Generating .asm files from .obj files ===")
+# asm目录中记录每个.asm对应目标文件内容哈希的缓存文件
+ASM_CACHE_FILE = ".asm_cache.json"
+
+def disassemble_command(dumpbin_tool, obj_file):
+    """生成反汇编命令（dumpbin /DISASM或objdump）"""
+    if is_gnu_toolchain(dumpbin_tool):
+        return dumpbin_tool.disassemble_command(obj_file)
+    return [dumpbin_tool, "/DISASM", obj_file]
+
+def listing_cache_key(obj_file, disasm_cmd):
+    """目标文件内容和反汇编参数的SHA-256，任一变化都需要重新生成"""
+    digest = hashlib.sha256()
+    # 命令中的目标文件路径不参与哈希，只有工具和选项会影响输出
+    for arg in disasm_cmd:
+        if arg != obj_file:
+            digest.update(arg.encode('utf-8'))
+            digest.update(b"\0")
+    with open(obj_file, 'rb') as f:
+        for chunk in iter(lambda: f.read(1 << 20), b""):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+def load_asm_cache(asm_dir):
+    cache_path = os.path.join(asm_dir, ASM_CACHE_FILE)
+    try:
+        with open(cache_path, 'r', encoding='utf-8') as f:
+            cache = json.load(f)
+        return cache if isinstance(cache, dict) else {}
+    except (OSError, ValueError):
+        return {}
+
+def save_asm_cache(asm_dir, cache):
+    cache_path = os.path.join(asm_dir, ASM_CACHE_FILE)
+    # 先写临时文件再替换，中断时不会留下损坏的缓存
+    temp_path = cache_path + ".tmp"
+    with open(temp_path, 'w', encoding='utf-8') as f:
+        json.dump(cache, f, indent=2, sort_keys=True)
+    os.replace(temp_path, cache_path)
+
+def disassemble_object(obj_file, asm_file, disasm_cmd):
+    """在工作线程中运行反汇编器并写出.asm文件，返回是否成功"""
+    result = run_command(disasm_cmd, echo=False)
+    if not result:
+        return False
+
+    with open(asm_file, 'w', encoding='utf-8') as f:
+        f.write(f"; Disassembly of {os.path.basename(obj_file)}\n")
+        f.write(f"; Generated by extract_lib.py\n\n")
+        f.write(result.stdout)
+    return True
+
+def generate_asm_files(obj_dir, asm_dir, dumpbin_tool, jobs=None, use_cache=True):
+    """从目标文件生成.asm文件
+
+    反汇编器进程最多jobs个同时运行（默认等于CPU数）。目标文件内容和反汇编
+    参数的哈希与上次生成时相同、且.asm仍然存在时跳过该文件。
+    """
+    print(f"\n=== Generating .asm files from object files ===")
     
     # 创建输出目录
     os.makedirs(asm_dir, exist_ok=True)
     
-    # 查找所有.obj文件
-    obj_files = glob.glob(os.path.join(obj_dir, "*.obj"))
+    # 查找所有目标文件
+    obj_files = find_object_files(obj_dir)
     
     if not obj_files:
-        print("No .obj files found")
+        print("No object files found")
         return False
     
-    success_count = 0
+    cache = load_asm_cache(asm_dir) if use_cache else {}
+    new_cache = {}
+    pending = []
+    skipped_count = 0
+    
     for obj_file in obj_files:
-        obj_name = os.path.basename(obj_file)
-        asm_name = obj_name.replace('.obj', '.asm')
+        asm_name = os.path.splitext(os.path.basename(obj_file))[0] + '.asm'
         asm_file = os.path.join(asm_dir, asm_name)
+        disasm_cmd = disassemble_command(dumpbin_tool, obj_file)
+        key = listing_cache_key(obj_file, disasm_cmd)
         
-        print(f"Generating {asm_name}...")
-        
-        # 使用dumpbin生成反汇编
-        dumpbin_cmd = [dumpbin_tool, "/DISASM", obj_file]
-        result = run_command(dumpbin_cmd)
+        if use_cache and cache.get(asm_name) == key and os.path.exists(asm_file):
+            new_cache[asm_name] = key
+            skipped_count += 1
+            continue
+        pending.append((asm_name, asm_file, obj_file, disasm_cmd, key))
+    
+    if skipped_count:
+        print(f"Up to date: {skipped_count} .asm files (unchanged objects)")
+    
+    success_count = skipped_count
+    if pending:
+        workers = max(1, min(jobs or os.cpu_count() or 1, len(pending)))
+        print(f"Disassembling {len(pending)} object files with {workers} parallel jobs...")
         
-        if result:
-            # 将输出写入.asm文件
-            with open(asm_file, 'w', encoding='utf-8') as f:
-                f.write(f"; Disassembly of {obj_name}\n")
-                f.write(f"; Generated by extract_lib.py\n\n")
-                f.write(result.stdout)
-            
-            print(f"✓ Generated: {asm_name}")
-            success_count += 1
-        else:
-            print(f"✗ Failed to generate: {asm_name}")
+        # 工作是外部反汇编器进程，线程只负责启动和收集输出
+        with ThreadPoolExecutor(max_workers=workers) as executor:
+            futures = {
+                executor.submit(disassemble_object, obj_file, asm_file, disasm_cmd): (asm_name, key)
+                for asm_name, asm_file, obj_file, disasm_cmd, key in pending
+            }
+            for future in as_completed(futures):
+                asm_name, key = futures[future]
+                try:
+                    ok = future.result()
+                except OSError as e:
+                    print(f"Error writing {asm_name}: {e}")
+                    ok = False
+                if ok:
+                    new_cache[asm_name] = key
+                    print(f"✓ Generated: {asm_name}")
+                    success_count += 1
+                else:
+                    print(f"✗ Failed to generate: {asm_name}")
+    
+    # 库中已经不存在的目标文件，删除上次为它生成的.asm
+    current_names = {os.path.splitext(os.path.basename(obj_file))[0] + '.asm' for obj_file in obj_files}
+    for stale_name in set(cache) - current_names:
+        stale_file = os.path.join(asm_dir, stale_name)
+        if os.path.exists(stale_file):
+            os.remove(stale_file)
+            print(f"Removed stale listing: {stale_name}")
+    
+    # 失败的文件不写入缓存，下次重新生成
+    save_asm_cache(asm_dir, new_cache)
     
     print(f"\nSuccessfully generated {success_count}/{len(obj_files)} .asm files")
     return success_count > 0
 
-def generate_summary_report(lib_file, obj_dir, asm_dir, output_dir):
-    """生成提取报告"""
+def generate_summary_report(lib_file, obj_dir, asm_dir, output_dir, symbol_tool=None):
+    """生成提取报告，给出symbol_tool时附带各目标文件定义的符号"""
     report_file = os.path.join(output_dir, "extraction_report.txt")
     
     with open(report_file, 'w', encoding='utf-8') as f:
@@ -277,9 +521,9 @@ def generate_summary_report(lib_file, obj_dir, asm_dir, output_dir):
         f.write(f"Source Library: {lib_file}\n")
         f.write(f"Extraction Time: {subprocess.run(['date', '/t'], capture_output=True, text=True, shell=True).stdout.strip()}\n\n")
         
-        # 统计.obj文件
-        obj_files = glob.glob(os.path.join(obj_dir, "*.obj"))
-        f.write(f"Extracted .obj files ({len(obj_files)}):\n")
+        # 统计目标文件
+        obj_files = find_object_files(obj_dir)
+        f.write(f"Extracted object files ({len(obj_files)}):\n")
         for obj_file in obj_files:
             size = os.path.getsize(obj_file)
             f.write(f"  - {os.path.basename(obj_file)} ({size:,} bytes)\n")
@@ -293,10 +537,20 @@ def generate_summary_report(lib_file, obj_dir, asm_dir, output_dir):
             size = os.path.getsize(asm_file)
             f.write(f"  - {os.path.basename(asm_file)} ({size:,} bytes)\n")
         
+        # 各目标文件定义的符号（nm --defined-only）
+        if symbol_tool:
+            f.write("\n")
+            f.write("Defined symbols:\n")
+            for obj_file in obj_files:
+                symbols = list_symbols(symbol_tool, obj_file)
+                f.write(f"  {os.path.basename(obj_file)} ({len(symbols)} symbols):\n")
+                for symbol in symbols:
+                    f.write(f"    {symbol}\n")
+        
         f.write("\n")
         f.write("Directory Structure:\n")
         f.write(f"  {output_dir}/\n")
-        f.write(f"  ├── obj/          # Extracted .obj files\n")
+        f.write(f"  ├── obj/          # Extracted object files\n")
         f.write(f"  ├── asm/          # Generated .asm files\n")
         f.write(f"  └── extraction_report.txt\n")
     
@@ -439,13 +693,7 @@ def analyze_library_differences(debug_lib, release_lib, dumpbin_tool):
         }
         
         # 获取符号信息
-        symbols_cmd = [dumpbin_tool, "/SYMBOLS", lib_file]
-        result = run_command(symbols_cmd, capture_output=True)
-        if result:
-            for line in result.stdout.split('\n'):
-                line = line.strip()
-                if 'External' in line or 'Static' in line:
-                    info['symbols'].append(line)
+        info['symbols'] = list_symbols(dumpbin_tool, lib_file)
         
         return info
     
@@ -518,13 +766,14 @@ def generate_conversion_report(debug_lib_file, release_lib_file, output_base_dir
     
     print(f"✓ Generated conversion report: {report_file}")
 
-def process_both_configurations(project_root, output_base_dir, lib_tool, dumpbin_tool, clean=False):
+def process_both_configurations(project_root, output_base_dir, lib_tool, dumpbin_tool, clean=False,
+                                toolchain="msvc", jobs=None, use_cache=True):
     """同时处理debug和release两个配置的库文件"""
     print(f"\n=== Processing both Debug and Release configurations ===")
     
-    # 定义两个配置的库文件路径
-    debug_lib_file = os.path.join(project_root, "build", "lib", "Debug", "utils.lib")
-    release_lib_file = os.path.join(project_root, "build", "lib", "Release", "utils.lib")
+    # 定义两个配置的库文件路径（两个配置必须来自不同的构建目录）
+    debug_lib_file = find_default_lib(project_root, "Debug", toolchain, allow_shared=False)
+    release_lib_file = find_default_lib(project_root, "Release", toolchain, allow_shared=False)
     
     # 检查文件是否存在
     debug_exists = os.path.exists(debug_lib_file)
@@ -533,8 +782,12 @@ def process_both_configurations(project_root, output_base_dir, lib_tool, dumpbin
     if not debug_exists and not release_exists:
         print("Error: Neither Debug nor Release library files found.")
         print("Please build the project first using:")
-        print("  python bootstrap.py --config Debug")
-        print("  python bootstrap.py --config Release")
+        if toolchain == "msvc":
+            print("  python bootstrap.py --config Debug")
+            print("  python bootstrap.py --config Release")
+        else:
+            print("  cmake -S . -B build-debug -DCMAKE_BUILD_TYPE=Debug && cmake --build build-debug")
+            print("  cmake -S . -B build-release -DCMAKE_BUILD_TYPE=Release && cmake --build build-release")
         return False
     
     if not debug_exists:
@@ -566,9 +819,10 @@ def process_both_configurations(project_root, output_base_dir, lib_tool, dumpbin
         # 提取Debug .obj文件
         if extract_obj_files(debug_lib_file, debug_obj_dir, lib_tool):
             # 生成Debug .asm文件
-            if generate_asm_files(debug_obj_dir, debug_asm_dir, dumpbin_tool):
+            if generate_asm_files(debug_obj_dir, debug_asm_dir, dumpbin_tool, jobs, use_cache):
                 # 生成Debug报告
-                generate_summary_report(debug_lib_file, debug_obj_dir, debug_asm_dir, debug_output_dir)
+                generate_summary_report(debug_lib_file, debug_obj_dir, debug_asm_dir, debug_output_dir,
+                                        dumpbin_tool if is_gnu_toolchain(dumpbin_tool) else None)
                 success_count += 1
                 print("✓ Debug configuration processed successfully")
             else:
@@ -589,9 +843,10 @@ def process_both_configurations(project_root, output_base_dir, lib_tool, dumpbin
         # 提取Release .obj文件
         if extract_obj_files(release_lib_file, release_obj_dir, lib_tool):
             # 生成Release .asm文件
-            if generate_asm_files(release_obj_dir, release_asm_dir, dumpbin_tool):
+            if generate_asm_files(release_obj_dir, release_asm_dir, dumpbin_tool, jobs, use_cache):
                 # 生成Release报告
-                generate_summary_report(release_lib_file, release_obj_dir, release_asm_dir, release_output_dir)
+                generate_summary_report(release_lib_file, release_obj_dir, release_asm_dir, release_output_dir,
+                                        dumpbin_tool if is_gnu_toolchain(dumpbin_tool) else None)
                 success_count += 1
                 print("✓ Release configuration processed successfully")
             else:
@@ -636,12 +891,12 @@ def generate_comparison_report(debug_lib_file, release_lib_file, output_base_dir
         debug_obj_dir = os.path.join(output_base_dir, "debug", "obj")
         release_obj_dir = os.path.join(output_base_dir, "release", "obj")
         
-        debug_obj_files = glob.glob(os.path.join(debug_obj_dir, "*.obj")) if os.path.exists(debug_obj_dir) else []
-        release_obj_files = glob.glob(os.path.join(release_obj_dir, "*.obj")) if os.path.exists(release_obj_dir) else []
+        debug_obj_files = find_object_files(debug_obj_dir) if os.path.exists(debug_obj_dir) else []
+        release_obj_files = find_object_files(release_obj_dir) if os.path.exists(release_obj_dir) else []
         
-        f.write("Extracted .obj Files Comparison:\n")
-        f.write(f"  Debug .obj files:   {len(debug_obj_files)} files\n")
-        f.write(f"  Release .obj files: {len(release_obj_files)} files\n")
+        f.write("Extracted Object Files Comparison:\n")
+        f.write(f"  Debug object files:   {len(debug_obj_files)} files\n")
+        f.write(f"  Release object files: {len(release_obj_files)} files\n")
         
         if debug_obj_files and release_obj_files:
             debug_obj_total_size = sum(os.path.getsize(f) for f in debug_obj_files)
@@ -676,25 +931,9 @@ def generate_comparison_report(debug_lib_file, release_lib_file, output_base_dir
         if dumpbin_tool:
             f.write("Symbol Analysis:\n")
             
-            # 分析Debug库符号
-            debug_symbols = []
-            symbols_cmd = [dumpbin_tool, "/SYMBOLS", debug_lib_file]
-            result = run_command(symbols_cmd, capture_output=True)
-            if result:
-                for line in result.stdout.split('\n'):
-                    line = line.strip()
-                    if 'External' in line or 'Static' in line:
-                        debug_symbols.append(line)
-            
-            # 分析Release库符号
-            release_symbols = []
-            symbols_cmd = [dumpbin_tool, "/SYMBOLS", release_lib_file]
-            result = run_command(symbols_cmd, capture_output=True)
-            if result:
-                for line in result.stdout.split('\n'):
-                    line = line.strip()
-                    if 'External' in line or 'Static' in line:
-                        release_symbols.append(line)
+            # 分析Debug和Release库符号
+            debug_symbols = list_symbols(dumpbin_tool, debug_lib_file)
+            release_symbols = list_symbols(dumpbin_tool, release_lib_file)
             
             f.write(f"  Debug symbols count:   {len(debug_symbols)}\n")
             f.write(f"  Release symbols count: {len(release_symbols)}\n")
@@ -735,6 +974,15 @@ def main():
                        help="Analyze differences between debug and release libraries (requires --convert-to-release)")
     parser.add_argument("--process-both", action="store_true",
                        help="Process both Debug and Release configurations simultaneously")
+    parser.add_argument("--toolchain", default="auto", choices=["auto", "msvc", "gnu"],
+                       help="Library tools: msvc (lib.exe/dumpbin.exe) or gnu (ar/objdump/nm); "
+                            "auto picks gnu for .a files and non-Windows hosts (default: auto)")
+    parser.add_argument("--jobs", "-j", type=int, default=None,
+                       help="Number of disassembler processes to run in parallel (default: CPU count)")
+    parser.add_argument("--no-cache", action="store_true",
+                       help="Regenerate every .asm listing even if its object file is unchanged")
+    parser.add_argument("--asm-syntax", default="intel", choices=["intel", "att"],
+                       help="x86 assembly syntax for objdump listings (default: intel, matching dumpbin)")
     
     args = parser.parse_args()
     
@@ -746,22 +994,32 @@ def main():
     
     print("=== Library Processing Tool ===")
     
-    # 查找工具
-    lib_tool = find_lib_tool()
-    if not lib_tool:
-        print("Error: lib.exe not found. Please ensure Visual Studio is installed.")
-        return 1
+    # 确定工具链
+    toolchain = detect_toolchain(args.toolchain, args.lib_file)
+    print(f"Toolchain: {toolchain}")
+    
+    # 查找工具：gnu工具链的ar/objdump/nm在同一个对象里，同时充当lib_tool和dumpbin_tool
+    if toolchain == "gnu":
+        lib_tool = find_gnu_toolchain(args.asm_syntax)
+        if not lib_tool:
+            return 1
+    else:
+        lib_tool = find_lib_tool()
+        if not lib_tool:
+            print("Error: lib.exe not found. Please ensure Visual Studio is installed.")
+            return 1
     
     # 如果需要同时处理两个配置
     if args.process_both:
         print("Mode: Process both Debug and Release configurations")
         
-        dumpbin_tool = find_dumpbin_tool()
+        dumpbin_tool = lib_tool if toolchain == "gnu" else find_dumpbin_tool()
         if not dumpbin_tool:
             print("Error: dumpbin.exe not found. Please ensure Visual Studio is installed.")
             return 1
         
-        if process_both_configurations(project_root, output_base_dir, lib_tool, dumpbin_tool, args.clean):
+        if process_both_configurations(project_root, output_base_dir, lib_tool, dumpbin_tool, args.clean,
+                                       toolchain, args.jobs, not args.no_cache):
             print(f"\n=== Both configurations processed successfully! ===")
             print(f"Output directory: {output_base_dir}")
             print(f"  - Debug files: {os.path.join(output_base_dir, 'debug')}")
@@ -781,7 +1039,7 @@ def main():
     if args.lib_file:
         lib_file = args.lib_file
     else:
-        lib_file = os.path.join(project_root, "build", "lib", args.config, "utils.lib")
+        lib_file = find_default_lib(project_root, args.config, toolchain)
     
     if not os.path.exists(lib_file):
         print(f"Error: Library file not found: {lib_file}")
@@ -797,6 +1055,11 @@ def main():
     if args.convert_to_release:
         print("Mode: Convert debug library to release library")
         
+        if toolchain == "gnu":
+            print("Error: --convert-to-release requires the MSVC toolchain (lib.exe/editbin.exe).")
+            print("For GCC/Clang builds use 'objcopy --strip-debug' on the extracted objects instead.")
+            return 1
+        
         # 查找editbin工具
         editbin_tool = find_editbin_tool()
         if not editbin_tool:
@@ -846,7 +1109,7 @@ def main():
     config_lower = args.config.lower()
     print(f"Target configuration: {args.config}")
     
-    dumpbin_tool = find_dumpbin_tool()
+    dumpbin_tool = lib_tool if toolchain == "gnu" else find_dumpbin_tool()
     if not dumpbin_tool:
         print("Error: dumpbin.exe not found. Please ensure Visual Studio is installed.")
         return 1
@@ -858,23 +1121,24 @@ def main():
     
     print(f"Output directory: {config_output_dir}")
     
-    # 提取.obj文件
+    # 提取目标文件
     if not extract_obj_files(lib_file, obj_dir, lib_tool):
-        print("Failed to extract .obj files")
+        print("Failed to extract object files")
         return 1
     
     # 生成.asm文件
-    if not generate_asm_files(obj_dir, asm_dir, dumpbin_tool):
+    if not generate_asm_files(obj_dir, asm_dir, dumpbin_tool, args.jobs, not args.no_cache):
         print("Failed to generate .asm files")
         return 1
     
     # 生成报告
-    generate_summary_report(lib_file, obj_dir, asm_dir, config_output_dir)
+    generate_summary_report(lib_file, obj_dir, asm_dir, config_output_dir,
+                            dumpbin_tool if is_gnu_toolchain(dumpbin_tool) else None)
     
     print(f"\n=== Extraction completed successfully! ===")
     print(f"Configuration: {args.config}")
     print(f"Output directory: {config_output_dir}")
-    print(f"  - .obj files: {obj_dir}")
+    print(f"  - object files: {obj_dir}")
     print(f"  - .asm files: {asm_dir}")
     print(f"  - Report: {os.path.join(config_output_dir, 'extraction_report.txt')}")
     
@@ -24,6 +24,13 @@
     #define PLATFORM_UNKNOWN
 #endif
 
+// 类型对齐
+#if defined(_MSC_VER)
+    #define UTILS_ALIGNED(n) __declspec(align(n))
+#else
+    #define UTILS_ALIGNED(n) __attribute__((aligned(n)))
+#endif
+
 // 枚举类型
 typedef enum {
     STATUS_SUCCESS = 0,
@@ -79,10 +86,25 @@ typedef struct Node {
     struct Node* prev;
 } Node;
 
+// 竞技场分配器（按块进行指针递增分配，整体释放）
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock* current;      // 当前分配块
+    ArenaBlock* spare;        // 复位后保留的空闲块
+    size_t block_size;        // 默认块大小
+} Arena;
+
+typedef struct {
+    ArenaBlock* block;
+    size_t offset;
+} ArenaMark;
+
 typedef struct {
     Node* head;
     Node* tail;
     size_t count;
+    Arena* arena;             // 非NULL时节点从竞技场分配
 } LinkedList;
 
 typedef union {
@@ -92,14 +114,29 @@ typedef union {
     char c[8];
 } DataUnion;
 
+typedef enum { TYPE_INT, TYPE_FLOAT, TYPE_DOUBLE, TYPE_STRING } VariantType;
+
 typedef struct {
     DataUnion value;
-    enum { TYPE_INT, TYPE_FLOAT, TYPE_DOUBLE, TYPE_STRING } type;
+    VariantType type;
 } VariantData;
 
+// 分片计数器：每个分片独占一个缓存行，线程固定写入自己的分片，读取时求和
+#define SHARDED_COUNTER_SHARDS 32
+#define SHARDED_COUNTER_INIT(value) { { { (value) } } }
+
+typedef struct UTILS_ALIGNED(64) ShardedCounterShard {
+    volatile int64_t value;
+} ShardedCounterShard;
+
+typedef struct {
+    ShardedCounterShard shards[SHARDED_COUNTER_SHARDS];
+} ShardedCounter;
+
 // 函数指针类型定义
 typedef int (*CompareFunc)(const void* a, const void* b);
 typedef void (*CallbackFunc)(int value);
+typedef void (*BatchCallbackFunc)(const int* chunk, size_t count, void* ctx);
 typedef Status (*ProcessFunc)(void* data, size_t size);
 
 // ============================================================================
@@ -239,6 +276,8 @@ void destroy_linked_list(LinkedList* list);
 
 // 内存管理函数
 void* safe_malloc(size_t size);
+void* safe_calloc(size_t count, size_t size);
+void* safe_malloc_uninit(size_t size);
 void* safe_realloc(void* ptr, size_t new_size);
 void safe_free(void** ptr);
 Status memory_copy(void* dest, const void* src, size_t size);
@@ -287,8 +326,11 @@ Status bitfield_operations(BitField* bf);
 Status union_operations(DataUnion* data);
 
 // 静态和全局变量测试
-extern int global_counter;
+// no_params_function和get_static_value返回调用线程所在分片的值，单线程时等于计数器总数；
+// 多线程下的精确总数用get_global_counter读取
+extern ShardedCounter global_counter;
 Status increment_global_counter(void);
+int get_global_counter(void);
 Status get_static_value(void);
 
 // 内联函数
@@ -305,4 +347,404 @@ extern const int CONSTANT_VALUE;
 extern const char* const CONSTANT_STRING;
 extern const Point ORIGIN_POINT;
 
+// ============================================================================
+// 竞技场分配器
+// ============================================================================
+
+// alignment为0时使用默认对齐，否则必须是2的幂
+#define ARENA_DEFAULT_ALIGNMENT 16
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+Arena* arena_create(size_t block_size);
+void* arena_alloc(Arena* arena, size_t size, size_t alignment);
+void* arena_alloc_zeroed(Arena* arena, size_t size, size_t alignment);
+ArenaMark arena_mark(const Arena* arena);
+void arena_reset_to_mark(Arena* arena, ArenaMark mark);
+void arena_reset(Arena* arena);
+void arena_destroy(Arena* arena);
+
+// 基于竞技场的对象创建（随竞技场复位/销毁一起释放，不要对其调用safe_free）
+Person* arena_create_person(Arena* arena, const char* name, int age, float height, double weight);
+LinkedList* arena_create_linked_list(Arena* arena);
+
+// ============================================================================
+// 尺寸分级池分配器
+// ============================================================================
+
+// 以UTILS_POOL_ALLOCATOR选项构建时，safe_malloc/safe_realloc/safe_free改走池分配器，
+// 此时这些内存只能用safe_free释放，不能直接free
+#define POOL_SIZE_CLASS_COUNT 40
+
+typedef struct {
+    int64_t live_bytes;
+    int64_t peak_bytes;
+    int64_t total_allocations;
+    int64_t total_frees;
+    int64_t large_allocations;
+    int64_t mapped_allocations;
+    int64_t realloc_count;
+    int64_t realloc_in_place;
+    int64_t class_allocations[POOL_SIZE_CLASS_COUNT];
+} PoolAllocatorStats;
+
+void* pool_malloc(size_t size);
+void* pool_calloc(size_t count, size_t size);
+void* pool_realloc(void* ptr, size_t new_size);
+void pool_free(void* ptr);
+void pool_thread_cache_flush(void);
+size_t pool_size_class_bytes(size_t size_class);
+Status pool_get_stats(PoolAllocatorStats* stats);
+Status pool_dump_stats(FILE* stream);
+
+// ============================================================================
+// 线程池
+// ============================================================================
+
+// 并行循环任务：处理[begin, end)区间，worker_index在[0, thread_pool_concurrency)内，
+// 可用于索引每线程的临时缓冲区
+typedef struct ThreadPool ThreadPool;
+typedef void (*ParallelForFunc)(size_t begin, size_t end, size_t worker_index, void* ctx);
+
+size_t utils_cpu_count(void);
+ThreadPool* thread_pool_create(size_t num_threads);   // 0表示使用全部CPU，包含调用线程
+void thread_pool_destroy(ThreadPool* pool);
+size_t thread_pool_concurrency(const ThreadPool* pool);
+// pool为NULL时在调用线程串行执行；不可在任务内部嵌套调用同一个线程池
+Status thread_pool_parallel_for(ThreadPool* pool, size_t count, size_t grain,
+                                ParallelForFunc func, void* ctx);
+
+// ============================================================================
+// 大块内存操作
+// ============================================================================
+
+// 超过阈值时使用非临时流式写入（不污染缓存），dest和src不能重叠
+#define MEMORY_STREAMING_THRESHOLD_DEFAULT (8u * 1024 * 1024)
+
+Status memory_copy_large(void* dest, const void* src, size_t size);
+Status memory_set_large(void* ptr, int value, size_t size);
+Status memory_copy_parallel(ThreadPool* pool, void* dest, const void* src, size_t size);
+Status memory_set_parallel(ThreadPool* pool, void* ptr, int value, size_t size);
+// 整页部分通过madvise(MADV_DONTNEED)归还给内核，只能用于私有匿名内存
+Status memory_zero_pages(void* ptr, size_t size);
+void memory_set_streaming_threshold(size_t bytes);
+size_t memory_get_streaming_threshold(void);
+
+// ============================================================================
+// 快速整数格式化
+// ============================================================================
+
+// 输出十进制文本，不写结尾'\0'，返回字符数；out至少需要对应的MAX_CHARS字节
+#define UTILS_INT32_MAX_CHARS 11
+#define UTILS_INT64_MAX_CHARS 20
+
+size_t format_uint32(uint32_t value, char* out);
+size_t format_int32(int32_t value, char* out);
+size_t format_uint64(uint64_t value, char* out);
+size_t format_int64(int64_t value, char* out);
+// 把整数数组写成以delimiter分隔的文本并以'\0'结尾，空间不足时返回STATUS_ERROR
+Status format_int_array(const int* values, size_t count, char delimiter,
+                        char* buffer, size_t buffer_size, size_t* length);
+
+// ============================================================================
+// 批量整数解析
+// ============================================================================
+
+// 从原始缓冲区解析以空白、','或';'分隔的十进制整数（可带正负号）。
+// 遇到格式错误或溢出返回STATUS_ERROR，输出数组已满返回STATUS_OUT_OF_MEMORY，
+// 两种情况下error_offset都指向出错token的起始偏移，count为已解析的个数
+Status parse_int_array(const char* data, size_t length, int* values, size_t capacity,
+                       size_t* count, size_t* error_offset);
+
+// ============================================================================
+// 输出缓冲区
+// ============================================================================
+
+// 可增长的字节缓冲区：先在内存中拼接输出，再一次性写到文件描述符或FILE*。
+// 设置了sink时，长度超过flush_threshold后自动写出到sink
+#define OUTPUT_BUFFER_DEFAULT_CAPACITY (64 * 1024)
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    FILE* sink;
+    size_t flush_threshold;
+} OutputBuffer;
+
+Status output_buffer_init(OutputBuffer* buffer, size_t initial_capacity);
+Status output_buffer_init_sink(OutputBuffer* buffer, FILE* sink, size_t flush_threshold);
+void output_buffer_free(OutputBuffer* buffer);     // 有sink时先写出剩余内容
+void output_buffer_clear(OutputBuffer* buffer);
+Status output_buffer_reserve(OutputBuffer* buffer, size_t additional);
+Status output_buffer_append(OutputBuffer* buffer, const char* data, size_t length);
+Status output_buffer_append_str(OutputBuffer* buffer, const char* str);
+Status output_buffer_append_char(OutputBuffer* buffer, char c);
+Status output_buffer_append_int(OutputBuffer* buffer, int64_t value);
+// 等价于"%.<precision>f"，precision不超过9且|value|<1e15时不经过snprintf
+Status output_buffer_append_double(OutputBuffer* buffer, double value, int precision);
+Status output_buffer_printf(OutputBuffer* buffer, const char* format, ...);
+Status output_buffer_flush_file(OutputBuffer* buffer, FILE* stream);
+Status output_buffer_flush_fd(OutputBuffer* buffer, int fd);
+
+// 与print_list/print_person/print_formatted输出相同，但写入缓冲区
+Status print_list_to_buffer(const LinkedList* list, OutputBuffer* buffer);
+Status print_person_to_buffer(const Person* person, OutputBuffer* buffer);
+Status print_persons_to_buffer(const Person* persons, size_t count, OutputBuffer* buffer);
+Status print_formatted_to_buffer(OutputBuffer* buffer, const char* format, ...);
+
+// ============================================================================
+// 分片计数器
+// ============================================================================
+
+// 递增只写调用线程的分片（relaxed原子操作），读取对所有分片求和；
+// 并发修改时读到的是某一时刻附近的近似值，全部线程停止修改后结果精确
+void sharded_counter_init(ShardedCounter* counter, int64_t value);
+void sharded_counter_add(ShardedCounter* counter, int64_t delta);
+// 返回调用线程所在分片递增后的值而不是总数，只访问本线程的缓存行
+int64_t sharded_counter_add_fetch(ShardedCounter* counter, int64_t delta);
+int64_t sharded_counter_read(const ShardedCounter* counter);
+
+// ============================================================================
+// 批量数组处理
+// ============================================================================
+
+// 按chunk_size（0表示默认值）把数组分块交给回调，一次间接调用处理整块，
+// 回调内部的循环可以被编译器向量化
+#define PROCESS_ARRAY_DEFAULT_CHUNK 1024
+
+Status process_array_batched(const int* array, size_t size, size_t chunk_size,
+                             BatchCallbackFunc callback, void* ctx);
+// 各块在线程池的多个线程上并发回调，调用顺序不确定，回调需自行保证线程安全
+Status process_array_parallel(ThreadPool* pool, const int* array, size_t size, size_t chunk_size,
+                              BatchCallbackFunc callback, void* ctx);
+
+// ============================================================================
+// 多级流水线
+// ============================================================================
+
+// 每个ProcessFunc阶段运行在独立线程上，相邻阶段之间是有界的单生产者/单消费者
+// 环形队列。缓冲区以指针形式在阶段间传递所有权（不复制），队列满时上游阻塞。
+// 缓冲区到达最后一个阶段后（包括中途出错被跳过的），由最后一个阶段的线程调用release回收
+#define PIPELINE_MAX_STAGES 16
+#define PIPELINE_DEFAULT_QUEUE_CAPACITY 64
+
+typedef struct Pipeline Pipeline;
+typedef void (*PipelineReleaseFunc)(void* data, size_t size, void* ctx);
+
+typedef struct {
+    uint64_t items;               // 处理的缓冲区数
+    uint64_t bytes;               // 处理的字节数
+    double busy_seconds;          // 阶段函数执行时间
+    double wait_seconds;          // 等待输入或等待下游队列空位的时间
+} PipelineStageStats;
+
+Pipeline* pipeline_create(size_t queue_capacity, PipelineReleaseFunc release, void* release_ctx);
+Status pipeline_add_stage(Pipeline* pipeline, ProcessFunc stage);
+Status pipeline_start(Pipeline* pipeline);
+// 只能由一个线程提交；data的所有权转移给流水线
+Status pipeline_submit(Pipeline* pipeline, void* data, size_t size);
+// 等待所有已提交的缓冲区处理完并停止阶段线程，返回按阶段顺序的第一个错误
+Status pipeline_finish(Pipeline* pipeline);
+// 在pipeline_finish之后读取才是完整结果
+Status pipeline_get_stage_stats(const Pipeline* pipeline, size_t stage, PipelineStageStats* stats);
+double pipeline_submit_wait_seconds(const Pipeline* pipeline);
+void pipeline_destroy(Pipeline* pipeline);
+
+// ============================================================================
+// 列式类型向量
+// ============================================================================
+
+// 一列只保存一种类型的连续数组，类型标记按列而不是按值存放。
+// 字符串列每个值占COLUMN_STRING_SIZE字节（与VariantData.value.c相同），
+// 不足部分用'\0'填充，批量操作依赖这一点按整块字节处理
+#define COLUMN_STRING_SIZE 8
+
+typedef struct {
+    VariantType type;
+    size_t count;
+    size_t capacity;
+    union {
+        int* i;
+        float* f;
+        double* d;
+        char (*s)[COLUMN_STRING_SIZE];
+        void* raw;
+    } values;
+} Column;
+
+Status column_init(Column* column, VariantType type, size_t capacity);
+void column_free(Column* column);
+Status column_reserve(Column* column, size_t capacity);
+Status column_append_int(Column* column, int value);
+Status column_append_float(Column* column, float value);
+Status column_append_double(Column* column, double value);
+Status column_append_string(Column* column, const char* value);   // 超过8字节时截断
+Status column_append_variant(Column* column, const VariantData* value);
+Status column_get_variant(const Column* column, size_t index, VariantData* value);
+// 数值列整体乘以factor，字符串列返回STATUS_ERROR
+Status column_scale(Column* column, int factor);
+// 字符串列整体转为大写，数值列返回STATUS_ERROR
+Status column_uppercase(Column* column);
+// 对整列做与variant_data_operations相同的操作（数值加倍，字符串转大写）
+Status column_operations(Column* column);
+
+// ============================================================================
+// 向量化数组扫描
+// ============================================================================
+
+// 返回第一个满足条件的下标，未找到返回SCAN_NOT_FOUND
+#define SCAN_NOT_FOUND ((size_t)-1)
+
+typedef enum {
+    SCAN_NONE,
+    SCAN_EQUAL,
+    SCAN_NEGATIVE
+} ScanReason;
+
+size_t scan_find_equal(const int* array, size_t size, int target);
+size_t scan_find_negative(const int* array, size_t size);
+// 第一个等于target或为负数的元素；两者同时成立时reason为SCAN_NEGATIVE
+size_t scan_find_equal_or_negative(const int* array, size_t size, int target, ScanReason* reason);
+size_t scan_count_equal(const int* array, size_t size, int target);
+// 当前CPU上选用的扫描内核（"avx512"、"avx2"、"sse2"或"scalar"）
+const char* scan_kernel_name(void);
+
+// ============================================================================
+// 批量分支求值
+// ============================================================================
+
+// 对并行数组逐项求值，结果与nested_switch_if/test_switch_statement完全相同，
+// 但用按操作码/颜色索引的查找表和谓词运算代替分支，避免大量输入时的分支预测失败
+Status nested_switch_if_batch(const int* a, const int* b, const char* ops, size_t count, Status* results);
+Status test_switch_statement_batch(const Color* colors, size_t count, Status* results);
+
+// ============================================================================
+// 整数矩阵
+// ============================================================================
+
+// 行主序、动态大小的int矩阵，元素(i, j)位于data[i * stride + j]，
+// 每行起始地址按64字节对齐
+typedef struct {
+    int* data;
+    void* block;              // 实际分配的内存
+    size_t rows;
+    size_t cols;
+    size_t stride;            // 行距（元素个数，>= cols）
+} IntMatrix;
+
+#define INT_MATRIX_AT(matrix, i, j) ((matrix)->data[(i) * (matrix)->stride + (j)])
+
+Status int_matrix_create(IntMatrix* matrix, size_t rows, size_t cols);
+void int_matrix_destroy(IntMatrix* matrix);
+Status int_matrix_fill(IntMatrix* matrix, int value);
+// 元素(i, j)赋值为i * cols + j，与complex_nested_loops相同
+Status int_matrix_fill_index(IntMatrix* matrix);
+Status int_matrix_sum(const IntMatrix* matrix, int64_t* sum);
+// dest必须是cols×rows的另一个矩阵
+Status int_matrix_transpose(const IntMatrix* src, IntMatrix* dest);
+// 按索引填充并按complex_nested_loops的规则求和（每个值累加一次，偶数另加3）
+Status int_matrix_fill_index_and_reduce(IntMatrix* matrix, int64_t* sum);
+Status int_matrix_fill_index_and_reduce_parallel(ThreadPool* pool, IntMatrix* matrix, int64_t* sum);
+
+// ============================================================================
+// 稠密矩阵乘法
+// ============================================================================
+
+// C = alpha * A * B + beta * C，A为m×k、B为k×n、C为m×n，均为行主序，
+// lda/ldb/ldc为行距（元素个数）。beta为0时不读取C的原有内容。
+// pool为NULL时在调用线程上执行；运行时根据CPU选择AVX2/FMA或通用微内核
+Status gemm_f32(ThreadPool* pool, size_t m, size_t n, size_t k,
+                float alpha, const float* a, size_t lda, const float* b, size_t ldb,
+                float beta, float* c, size_t ldc);
+Status gemm_f64(ThreadPool* pool, size_t m, size_t n, size_t k,
+                double alpha, const double* a, size_t lda, const double* b, size_t ldb,
+                double beta, double* c, size_t ldc);
+const char* gemm_kernel_name(void);
+
+// ============================================================================
+// 硬件性能计数器
+// ============================================================================
+
+// 作为一组同时计数（Linux perf_event_open），只统计调用线程的用户态事件。
+// 内核不支持、权限不足或非Linux平台时对应计数器不可用，不影响其余功能
+typedef enum {
+    PERF_COUNTER_CYCLES,
+    PERF_COUNTER_INSTRUCTIONS,
+    PERF_COUNTER_BRANCH_MISSES,
+    PERF_COUNTER_L1D_MISSES,          // L1数据缓存读缺失
+    PERF_COUNTER_LLC_MISSES,          // 末级缓存缺失
+    PERF_COUNTER_COUNT
+} PerfCounterKind;
+
+#define PERF_COUNTER_BIT(kind) (1u << (kind))
+
+typedef struct {
+    uint64_t values[PERF_COUNTER_COUNT];
+    uint32_t available;               // 有效计数的位掩码（PERF_COUNTER_BIT）
+    bool multiplexed;                 // 计数器被分时复用，数值按运行时间比例推算
+} PerfCounterValues;
+
+typedef struct PerfCounters PerfCounters;
+
+// 只在内存不足时返回NULL；没有可用计数器时也返回有效对象
+PerfCounters* perf_counters_create(void);
+void perf_counters_destroy(PerfCounters* counters);
+uint32_t perf_counters_available(const PerfCounters* counters);
+// 清零并开始计数
+Status perf_counters_start(PerfCounters* counters);
+// 停止计数并读出start以来的值
+Status perf_counters_stop(PerfCounters* counters, PerfCounterValues* values);
+const char* perf_counter_name(PerfCounterKind kind);
+
+// ============================================================================
+// 函数级追踪
+// ============================================================================
+
+// 以-DUTILS_ENABLE_TRACING=ON构建时（仅GCC/Clang），src/utils.c中的函数带
+// -finstrument-functions编译，每个线程在自己的缓冲区里记录各函数的调用次数、
+// 累计周期和调用事件。程序退出时自动输出按累计时间排序的报告：环境变量
+// UTILS_TRACE_REPORT指定报告文件（默认stderr），UTILS_TRACE_CHROME指定
+// Chrome trace-event JSON文件（可用chrome://tracing或Perfetto打开）。
+// 未启用时不插桩、没有开销，以下函数返回false/STATUS_ERROR
+bool utils_trace_enabled(void);
+Status utils_trace_write_report(FILE* stream);
+Status utils_trace_write_chrome_json(const char* filename);
+
+// ============================================================================
+// CPU特性检测
+// ============================================================================
+
+// 首次调用时用CPUID探测一次并缓存。AVX2/FMA/AVX-512只有在操作系统也启用了
+// 对应寄存器状态时才报告为可用。非x86平台全部为0。
+// 环境变量UTILS_CPU_DISABLE（逗号分隔的特性名）可屏蔽部分特性，须在首次调用前设置；
+// 依赖被屏蔽特性的扩展（如avx2之于fma、bmi2和avx512*）同时被屏蔽
+typedef enum {
+    CPU_FEATURE_SSE2     = 1u << 0,
+    CPU_FEATURE_SSE42    = 1u << 1,
+    CPU_FEATURE_POPCNT   = 1u << 2,
+    CPU_FEATURE_AVX2     = 1u << 3,
+    CPU_FEATURE_FMA      = 1u << 4,
+    CPU_FEATURE_BMI2     = 1u << 5,
+    CPU_FEATURE_AVX512F  = 1u << 6,
+    CPU_FEATURE_AVX512BW = 1u << 7
+} CpuFeature;
+
+uint32_t cpu_features(void);
+// features中的所有位都可用时返回true
+bool cpu_has_features(uint32_t features);
+const char* cpu_feature_name(CpuFeature feature);
+// 以空格分隔的特性名写入buffer（如"sse2 sse4.2 popcnt avx2"），返回写入的长度
+size_t cpu_features_format(char* buffer, size_t size);
+
+// ============================================================================
+// 内联快速路径
+// ============================================================================
+
+// 定义UTILS_INLINE时，add_integers、bitwise_*、create_point等简单纯函数的调用
+// 改用utils_inline.h中的static inline实现；库中的导出符号保持不变。
+// src/utils.c定义UTILS_NO_INLINE，以便给出这些函数的导出定义
+#if defined(UTILS_INLINE) && !defined(UTILS_NO_INLINE)
+#include "utils_inline.h"
+#endif
+
 #endif // UTILS_H 
\ No newline at end of file
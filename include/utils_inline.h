@@ -0,0 +1,90 @@
+#ifndef UTILS_INLINE_H
+#define UTILS_INLINE_H
+
+// ============================================================================
+// 简单纯函数的内联版本
+//
+// 定义UTILS_INLINE后由utils.h自动包含（CMake选项UTILS_INLINE=ON会为链接utils
+// 的目标加上该定义）。下列函数的调用被替换为头文件中的static inline实现，
+// 热循环里的调用不再需要call/ret，编译器也可以继续向量化整个循环，不依赖LTO。
+//
+// 替换用的是函数式宏，只作用于"名字后紧跟括号"的调用；取函数地址
+// （&add_integers或作为回调传递）仍然得到库中导出的符号，ABI不变。
+// 内联版本与src/utils.c中的实现语义完全相同，修改时两处必须同步。
+// ============================================================================
+
+#include "utils.h"
+
+static inline int utils_inline_add_integers(int a, int b) {
+    return a + b;
+}
+
+static inline float utils_inline_add_floats(float a, float b) {
+    return a + b;
+}
+
+static inline double utils_inline_add_doubles(double a, double b) {
+    return a + b;
+}
+
+static inline int utils_inline_subtract_integers(int a, int b) {
+    return a - b;
+}
+
+static inline int utils_inline_multiply_integers(int a, int b) {
+    return a * b;
+}
+
+static inline float utils_inline_divide_floats(float a, float b) {
+    return (b == 0.0f) ? 0.0f : a / b;
+}
+
+static inline int utils_inline_modulo_operation(int a, int b) {
+    return (b == 0) ? 0 : a % b;
+}
+
+static inline unsigned int utils_inline_bitwise_and(unsigned int a, unsigned int b) {
+    return a & b;
+}
+
+static inline unsigned int utils_inline_bitwise_or(unsigned int a, unsigned int b) {
+    return a | b;
+}
+
+static inline unsigned int utils_inline_bitwise_xor(unsigned int a, unsigned int b) {
+    return a ^ b;
+}
+
+static inline unsigned int utils_inline_bitwise_not(unsigned int a) {
+    return ~a;
+}
+
+static inline unsigned int utils_inline_left_shift(unsigned int value, int positions) {
+    return (positions < 0 || positions >= 32) ? value : value << positions;
+}
+
+static inline unsigned int utils_inline_right_shift(unsigned int value, int positions) {
+    return (positions < 0 || positions >= 32) ? value : value >> positions;
+}
+
+static inline Point utils_inline_create_point(int x, int y) {
+    Point p = {x, y};
+    return p;
+}
+
+#define add_integers(a, b)          utils_inline_add_integers(a, b)
+#define add_floats(a, b)            utils_inline_add_floats(a, b)
+#define add_doubles(a, b)           utils_inline_add_doubles(a, b)
+#define subtract_integers(a, b)     utils_inline_subtract_integers(a, b)
+#define multiply_integers(a, b)     utils_inline_multiply_integers(a, b)
+#define divide_floats(a, b)         utils_inline_divide_floats(a, b)
+#define modulo_operation(a, b)      utils_inline_modulo_operation(a, b)
+#define bitwise_and(a, b)           utils_inline_bitwise_and(a, b)
+#define bitwise_or(a, b)            utils_inline_bitwise_or(a, b)
+#define bitwise_xor(a, b)           utils_inline_bitwise_xor(a, b)
+#define bitwise_not(a)              utils_inline_bitwise_not(a)
+#define left_shift(value, pos)      utils_inline_left_shift(value, pos)
+#define right_shift(value, pos)     utils_inline_right_shift(value, pos)
+#define create_point(x, y)          utils_inline_create_point(x, y)
+
+#endif // UTILS_INLINE_H
@@ -0,0 +1,196 @@
+#include "utils.h"
+
+// ============================================================================
+// 竞技场分配器实现
+// ============================================================================
+
+struct ArenaBlock {
+    ArenaBlock* prev;
+    size_t size;              // 数据区容量
+    size_t offset;            // 已使用字节数
+};
+
+// 块头向上取整到默认对齐，保证数据区起始地址对齐
+#define ARENA_HEADER_SIZE \
+    ((sizeof(ArenaBlock) + ARENA_DEFAULT_ALIGNMENT - 1) & ~(size_t)(ARENA_DEFAULT_ALIGNMENT - 1))
+
+static char* arena_block_data(ArenaBlock* block) {
+    return (char*)block + ARENA_HEADER_SIZE;
+}
+
+static ArenaBlock* arena_new_block(Arena* arena, size_t min_size) {
+    size_t size = MAX(arena->block_size, min_size);
+
+    // 复用复位时保留的空闲块
+    if (arena->spare && arena->spare->size >= size) {
+        ArenaBlock* block = arena->spare;
+        arena->spare = NULL;
+        block->offset = 0;
+        return block;
+    }
+
+    if (size > SIZE_MAX - ARENA_HEADER_SIZE) {
+        return NULL;
+    }
+
+    ArenaBlock* block = (ArenaBlock*)malloc(ARENA_HEADER_SIZE + size);
+    if (!block) {
+        return NULL;
+    }
+
+    block->prev = NULL;
+    block->size = size;
+    block->offset = 0;
+    return block;
+}
+
+static void arena_release_block(Arena* arena, ArenaBlock* block) {
+    // 保留一个最大的块，避免请求级别的反复复位造成malloc抖动
+    if (!arena->spare) {
+        arena->spare = block;
+    } else if (block->size > arena->spare->size) {
+        free(arena->spare);
+        arena->spare = block;
+    } else {
+        free(block);
+    }
+}
+
+Arena* arena_create(size_t block_size) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    if (!arena) {
+        return NULL;
+    }
+
+    arena->current = NULL;
+    arena->spare = NULL;
+    arena->block_size = (block_size > 0) ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+
+    return arena;
+}
+
+void* arena_alloc(Arena* arena, size_t size, size_t alignment) {
+    if (!arena || size == 0) {
+        return NULL;
+    }
+
+    if (alignment == 0) {
+        alignment = ARENA_DEFAULT_ALIGNMENT;
+    }
+    if ((alignment & (alignment - 1)) != 0 || size > SIZE_MAX - alignment) {
+        return NULL;
+    }
+
+    ArenaBlock* block = arena->current;
+    if (block) {
+        uintptr_t base = (uintptr_t)arena_block_data(block);
+        uintptr_t aligned = (base + block->offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        size_t start = (size_t)(aligned - base);
+
+        if (start <= block->size && size <= block->size - start) {
+            block->offset = start + size;
+            return (void*)aligned;
+        }
+    }
+
+    // 当前块空间不足，申请新块（超大请求单独占用一个块）
+    block = arena_new_block(arena, size + alignment - 1);
+    if (!block) {
+        return NULL;
+    }
+    block->prev = arena->current;
+    arena->current = block;
+
+    uintptr_t base = (uintptr_t)arena_block_data(block);
+    uintptr_t aligned = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    block->offset = (size_t)(aligned - base) + size;
+
+    return (void*)aligned;
+}
+
+void* arena_alloc_zeroed(Arena* arena, size_t size, size_t alignment) {
+    void* ptr = arena_alloc(arena, size, alignment);
+    if (ptr) {
+        memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+ArenaMark arena_mark(const Arena* arena) {
+    ArenaMark mark = {NULL, 0};
+    if (arena && arena->current) {
+        mark.block = arena->current;
+        mark.offset = arena->current->offset;
+    }
+    return mark;
+}
+
+void arena_reset_to_mark(Arena* arena, ArenaMark mark) {
+    if (!arena) {
+        return;
+    }
+
+    while (arena->current && arena->current != mark.block) {
+        ArenaBlock* block = arena->current;
+        arena->current = block->prev;
+        arena_release_block(arena, block);
+    }
+
+    if (arena->current) {
+        arena->current->offset = mark.offset;
+    }
+}
+
+void arena_reset(Arena* arena) {
+    ArenaMark empty = {NULL, 0};
+    arena_reset_to_mark(arena, empty);
+}
+
+void arena_destroy(Arena* arena) {
+    if (!arena) {
+        return;
+    }
+
+    ArenaBlock* block = arena->current;
+    while (block) {
+        ArenaBlock* prev = block->prev;
+        free(block);
+        block = prev;
+    }
+    free(arena->spare);
+    free(arena);
+}
+
+// ============================================================================
+// 基于竞技场的对象创建
+// ============================================================================
+
+Person* arena_create_person(Arena* arena, const char* name, int age, float height, double weight) {
+    if (!arena || !name) {
+        return NULL;
+    }
+
+    Person* person = (Person*)arena_alloc(arena, sizeof(Person), 0);
+    if (person) {
+        *person = create_person(name, age, height, weight);
+    }
+    return person;
+}
+
+LinkedList* arena_create_linked_list(Arena* arena) {
+    if (!arena) {
+        return NULL;
+    }
+
+    LinkedList* list = (LinkedList*)arena_alloc(arena, sizeof(LinkedList), 0);
+    if (!list) {
+        return NULL;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->arena = arena;
+
+    return list;
+}
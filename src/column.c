@@ -0,0 +1,248 @@
+#include "utils.h"
+
+// ============================================================================
+// 列式类型向量
+//
+// VariantData数组每个值都带类型标记，逐个switch分派，且8字节的数据要占
+// 16字节。列按类型存成连续数组后，批量操作只在入口判断一次类型，内层
+// 循环是编译器可以直接向量化的简单循环。
+// ============================================================================
+
+#define COLUMN_DEFAULT_CAPACITY 16
+
+static size_t column_element_size(VariantType type) {
+    switch (type) {
+        case TYPE_INT:
+            return sizeof(int);
+        case TYPE_FLOAT:
+            return sizeof(float);
+        case TYPE_DOUBLE:
+            return sizeof(double);
+        case TYPE_STRING:
+            return COLUMN_STRING_SIZE;
+        default:
+            return 0;
+    }
+}
+
+Status column_init(Column* column, VariantType type, size_t capacity) {
+    if (!column || column_element_size(type) == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    column->type = type;
+    column->count = 0;
+    column->capacity = 0;
+    column->values.raw = NULL;
+
+    return (capacity > 0) ? column_reserve(column, capacity) : STATUS_SUCCESS;
+}
+
+void column_free(Column* column) {
+    if (!column) {
+        return;
+    }
+
+    free(column->values.raw);
+    column->values.raw = NULL;
+    column->count = 0;
+    column->capacity = 0;
+}
+
+Status column_reserve(Column* column, size_t capacity) {
+    if (!column) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (capacity <= column->capacity) {
+        return STATUS_SUCCESS;
+    }
+
+    size_t element_size = column_element_size(column->type);
+    if (capacity > SIZE_MAX / element_size) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    void* values = realloc(column->values.raw, capacity * element_size);
+    if (!values) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    column->values.raw = values;
+    column->capacity = capacity;
+    return STATUS_SUCCESS;
+}
+
+// 确保还能追加一个值，按倍数扩容
+static Status column_grow(Column* column) {
+    if (column->count < column->capacity) {
+        return STATUS_SUCCESS;
+    }
+
+    size_t capacity = (column->capacity > 0) ? column->capacity * 2 : COLUMN_DEFAULT_CAPACITY;
+    return column_reserve(column, capacity);
+}
+
+Status column_append_int(Column* column, int value) {
+    if (!column || column->type != TYPE_INT) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    Status status = column_grow(column);
+    if (status == STATUS_SUCCESS) {
+        column->values.i[column->count++] = value;
+    }
+    return status;
+}
+
+Status column_append_float(Column* column, float value) {
+    if (!column || column->type != TYPE_FLOAT) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    Status status = column_grow(column);
+    if (status == STATUS_SUCCESS) {
+        column->values.f[column->count++] = value;
+    }
+    return status;
+}
+
+Status column_append_double(Column* column, double value) {
+    if (!column || column->type != TYPE_DOUBLE) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    Status status = column_grow(column);
+    if (status == STATUS_SUCCESS) {
+        column->values.d[column->count++] = value;
+    }
+    return status;
+}
+
+Status column_append_string(Column* column, const char* value) {
+    if (!column || !value || column->type != TYPE_STRING) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    Status status = column_grow(column);
+    if (status == STATUS_SUCCESS) {
+        char* slot = column->values.s[column->count++];
+        size_t length = 0;
+        while (length < COLUMN_STRING_SIZE && value[length] != '\0') {
+            length++;
+        }
+        memcpy(slot, value, length);
+        memset(slot + length, 0, COLUMN_STRING_SIZE - length);
+    }
+    return status;
+}
+
+Status column_append_variant(Column* column, const VariantData* value) {
+    if (!column || !value || value->type != column->type) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    switch (value->type) {
+        case TYPE_INT:
+            return column_append_int(column, value->value.i);
+        case TYPE_FLOAT:
+            return column_append_float(column, value->value.f);
+        case TYPE_DOUBLE:
+            return column_append_double(column, value->value.d);
+        case TYPE_STRING:
+            // value.c不一定以'\0'结尾，最多取8个字节
+            return column_append_string(column, value->value.c);
+        default:
+            return STATUS_ERROR;
+    }
+}
+
+Status column_get_variant(const Column* column, size_t index, VariantData* value) {
+    if (!column || !value || index >= column->count) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    value->type = column->type;
+    switch (column->type) {
+        case TYPE_INT:
+            value->value.i = column->values.i[index];
+            break;
+        case TYPE_FLOAT:
+            value->value.f = column->values.f[index];
+            break;
+        case TYPE_DOUBLE:
+            value->value.d = column->values.d[index];
+            break;
+        case TYPE_STRING:
+            memcpy(value->value.c, column->values.s[index], COLUMN_STRING_SIZE);
+            break;
+        default:
+            return STATUS_ERROR;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+Status column_scale(Column* column, int factor) {
+    if (!column) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    size_t count = column->count;
+    switch (column->type) {
+        case TYPE_INT: {
+            int* values = column->values.i;
+            for (size_t i = 0; i < count; i++) {
+                values[i] *= factor;
+            }
+            break;
+        }
+        case TYPE_FLOAT: {
+            float* values = column->values.f;
+            float scale = (float)factor;
+            for (size_t i = 0; i < count; i++) {
+                values[i] *= scale;
+            }
+            break;
+        }
+        case TYPE_DOUBLE: {
+            double* values = column->values.d;
+            double scale = (double)factor;
+            for (size_t i = 0; i < count; i++) {
+                values[i] *= scale;
+            }
+            break;
+        }
+        default:
+            return STATUS_ERROR;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+Status column_uppercase(Column* column) {
+    if (!column) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (column->type != TYPE_STRING) {
+        return STATUS_ERROR;
+    }
+
+    // 填充的'\0'不是小写字母，因此可以把整列当作一段连续字节处理，
+    // 结果与逐个值遇到'\0'停止相同；无分支写法便于向量化
+    unsigned char* bytes = (unsigned char*)column->values.raw;
+    size_t length = column->count * COLUMN_STRING_SIZE;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char is_lower = (unsigned char)(bytes[i] - 'a') < 26;
+        bytes[i] = (unsigned char)(bytes[i] - (is_lower << 5));
+    }
+
+    return STATUS_SUCCESS;
+}
+
+Status column_operations(Column* column) {
+    if (!column) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    return (column->type == TYPE_STRING) ? column_uppercase(column) : column_scale(column, 2);
+}
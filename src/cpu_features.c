@@ -0,0 +1,194 @@
+#include "utils_internal.h"
+
+#if defined(UTILS_ARCH_X86) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+// ============================================================================
+// 运行时CPU特性检测
+//
+// 进程内只用CPUID探测一次，结果缓存在静态变量中。AVX系列除了CPU支持之外
+// 还要求操作系统在上下文切换时保存对应的寄存器状态（XCR0），否则视为不可用。
+// 环境变量UTILS_CPU_DISABLE可以屏蔽部分特性（逗号分隔的特性名，如
+// "avx512f,avx2"），用来在新机器上验证老机器会走的代码路径。屏蔽一个特性时
+// 依赖它的特性一并屏蔽，结果总是某种真实存在的老机器的特性组合。
+// ============================================================================
+
+static const char* const cpu_feature_names[] = {
+    "sse2", "sse4.2", "popcnt", "avx2", "fma", "bmi2", "avx512f", "avx512bw"
+};
+
+#define CPU_FEATURE_NAME_COUNT (sizeof(cpu_feature_names) / sizeof(cpu_feature_names[0]))
+
+#define CPU_FEATURE_AVX512_ALL (CPU_FEATURE_AVX512F | CPU_FEATURE_AVX512BW)
+#define CPU_FEATURE_AVX2_ALL (CPU_FEATURE_AVX2 | CPU_FEATURE_FMA | CPU_FEATURE_BMI2 | CPU_FEATURE_AVX512_ALL)
+
+// 屏蔽feature时一并屏蔽的特性（feature中任一位被屏蔽即生效）。支持AVX2的CPU
+// 都有SSE4.2和POPCNT；FMA和BMI2与AVX2同代引入，没有AVX2的CPU也没有它们，
+// 而支持AVX-512的CPU都有FMA和BMI2
+static const struct {
+    uint32_t feature;
+    uint32_t dependents;
+} cpu_feature_dependents[] = {
+    {CPU_FEATURE_SSE2, CPU_FEATURE_SSE42 | CPU_FEATURE_AVX2_ALL},
+    {CPU_FEATURE_SSE42, CPU_FEATURE_AVX2_ALL},
+    {CPU_FEATURE_POPCNT, CPU_FEATURE_AVX2_ALL},
+    {CPU_FEATURE_AVX2, CPU_FEATURE_AVX2_ALL},
+    {CPU_FEATURE_FMA | CPU_FEATURE_BMI2, CPU_FEATURE_AVX512_ALL},
+    {CPU_FEATURE_AVX512F, CPU_FEATURE_AVX512BW},
+};
+
+static uint32_t cpu_feature_mask;
+static UtilsOnce cpu_features_once = UTILS_ONCE_INIT;
+
+#if defined(UTILS_ARCH_X86)
+static void cpu_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++) {
+        regs[i] = (unsigned int)info[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t cpu_xgetbv(void) {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((uint64_t)high << 32) | low;
+#endif
+}
+
+static uint32_t cpu_probe(void) {
+    unsigned int regs0[4] = {0};
+    unsigned int regs1[4] = {0};
+    unsigned int regs7[4] = {0};
+
+    cpu_cpuid(0, 0, regs0);
+    unsigned int max_leaf = regs0[0];
+    if (max_leaf < 1) {
+        return 0;
+    }
+    cpu_cpuid(1, 0, regs1);
+    if (max_leaf >= 7) {
+        cpu_cpuid(7, 0, regs7);
+    }
+
+    uint32_t features = 0;
+    if (regs1[3] & (1u << 26)) features |= CPU_FEATURE_SSE2;
+    if (regs1[2] & (1u << 20)) features |= CPU_FEATURE_SSE42;
+    if (regs1[2] & (1u << 23)) features |= CPU_FEATURE_POPCNT;
+    if (regs7[1] & (1u << 8))  features |= CPU_FEATURE_BMI2;
+
+    // OSXSAVE为0时不能执行xgetbv，所有AVX特性都不可用
+    bool osxsave = (regs1[2] & (1u << 27)) != 0;
+    bool avx = (regs1[2] & (1u << 28)) != 0;
+    if (!osxsave || !avx) {
+        return features;
+    }
+
+    uint64_t xcr0 = cpu_xgetbv();
+    bool ymm_enabled = (xcr0 & 0x6) == 0x6;              // XMM和YMM高半部分
+    bool zmm_enabled = ymm_enabled && (xcr0 & 0xE0) == 0xE0;  // opmask和ZMM
+
+    if (ymm_enabled) {
+        if (regs7[1] & (1u << 5))  features |= CPU_FEATURE_AVX2;
+        if (regs1[2] & (1u << 12)) features |= CPU_FEATURE_FMA;
+    }
+    if (zmm_enabled) {
+        if (regs7[1] & (1u << 16)) features |= CPU_FEATURE_AVX512F;
+        if (regs7[1] & (1u << 30)) features |= CPU_FEATURE_AVX512BW;
+    }
+    return features;
+}
+#endif
+
+// 解析UTILS_CPU_DISABLE，返回要屏蔽的特性位
+static uint32_t cpu_disabled_features(void) {
+    const char* value = getenv("UTILS_CPU_DISABLE");
+    if (!value) {
+        return 0;
+    }
+
+    uint32_t disabled = 0;
+    while (*value) {
+        size_t length = strcspn(value, ",");
+        for (size_t i = 0; i < CPU_FEATURE_NAME_COUNT; i++) {
+            if (strlen(cpu_feature_names[i]) == length &&
+                strncmp(cpu_feature_names[i], value, length) == 0) {
+                disabled |= 1u << i;
+            }
+        }
+        value += length;
+        if (*value == ',') {
+            value++;
+        }
+    }
+
+    // 依赖表按从基础到扩展的顺序排列，一遍即可得到传递闭包
+    for (size_t i = 0; i < sizeof(cpu_feature_dependents) / sizeof(cpu_feature_dependents[0]); i++) {
+        if (disabled & cpu_feature_dependents[i].feature) {
+            disabled |= cpu_feature_dependents[i].dependents;
+        }
+    }
+    return disabled;
+}
+
+static void cpu_features_detect(void) {
+    uint32_t features = 0;
+#if defined(UTILS_ARCH_X86)
+    features = cpu_probe();
+#endif
+    cpu_feature_mask = features & ~cpu_disabled_features();
+}
+
+uint32_t cpu_features(void) {
+    utils_call_once(&cpu_features_once, cpu_features_detect);
+    return cpu_feature_mask;
+}
+
+bool cpu_has_features(uint32_t features) {
+    return (cpu_features() & features) == features;
+}
+
+const char* cpu_feature_name(CpuFeature feature) {
+    for (size_t i = 0; i < CPU_FEATURE_NAME_COUNT; i++) {
+        if ((uint32_t)feature == (1u << i)) {
+            return cpu_feature_names[i];
+        }
+    }
+    return "unknown";
+}
+
+size_t cpu_features_format(char* buffer, size_t size) {
+    if (!buffer || size == 0) {
+        return 0;
+    }
+
+    uint32_t features = cpu_features();
+    size_t length = 0;
+    buffer[0] = '\0';
+    for (size_t i = 0; i < CPU_FEATURE_NAME_COUNT; i++) {
+        if (!(features & (1u << i))) {
+            continue;
+        }
+        int written = snprintf(buffer + length, size - length, "%s%s",
+                               length > 0 ? " " : "", cpu_feature_names[i]);
+        if (written < 0 || (size_t)written >= size - length) {
+            // 截断时保留已写入的完整名称
+            buffer[length] = '\0';
+            break;
+        }
+        length += (size_t)written;
+    }
+    if (length == 0) {
+        snprintf(buffer, size, "none");
+        length = strlen(buffer);
+    }
+    return length;
+}
@@ -0,0 +1,441 @@
+#include "utils_internal.h"
+
+// ============================================================================
+// 稠密矩阵乘法 C = alpha * A * B + beta * C（行主序）
+//
+// 按BLIS的五层循环组织：B按KC×NC打包成宽NR的列条，A按MC×KC打包成高MR的
+// 行条，最内层的微内核在寄存器中累加一个MR×NR的C块。打包后的A块留在L2、
+// B条留在L1，微内核只做连续读取。ic方向的MC块分给线程池并行，每个工作
+// 线程使用自己的A打包缓冲区。
+//
+// 微内核在运行时选择：cpu_features()报告AVX2和FMA时使用手写的AVX2内核，否则使用
+// 由编译器自动向量化的通用C内核。两者的MR/NR相同，打包格式通用。
+// ============================================================================
+
+#define GEMM_F32_MR 6
+#define GEMM_F32_NR 16
+#define GEMM_F64_MR 6
+#define GEMM_F64_NR 8
+
+#define GEMM_MC 72
+#define GEMM_KC 256
+#define GEMM_NC 4096
+
+// 边缘块临时缓冲区的元素个数上限（按double计）
+#define GEMM_MAX_TILE (GEMM_F32_MR * GEMM_F32_NR)
+
+typedef void (*GemmPackFunc)(size_t count, size_t kc, const void* src, size_t ld, void* dest);
+typedef void (*GemmKernelFunc)(size_t kc, const void* a, const void* b, void* c, size_t ldc,
+                               double alpha, double beta);
+typedef void (*GemmMergeFunc)(size_t mr, size_t nr, const void* tile, size_t tile_ld,
+                              void* c, size_t ldc, double beta);
+typedef void (*GemmScaleFunc)(size_t m, size_t n, void* c, size_t ldc, double beta);
+
+typedef struct {
+    size_t element_size;
+    size_t mr;
+    size_t nr;
+    GemmPackFunc pack_a;
+    GemmPackFunc pack_b;
+    GemmKernelFunc kernel;
+    GemmMergeFunc merge;
+    GemmScaleFunc scale;
+} GemmImpl;
+
+// ============================================================================
+// 打包、合并和缩放（float和double各生成一份）
+// ============================================================================
+
+// A的rows行×kc列打包为高MR的行条，行条内按列连续存放，不足MR的部分补0
+#define GEMM_DEFINE_PACK_A(suffix, type, MR)                                        \
+static void gemm_pack_a_##suffix(size_t rows, size_t kc, const void* src, size_t lda, \
+                                 void* dest) {                                      \
+    const type* a = (const type*)src;                                               \
+    type* out = (type*)dest;                                                        \
+    for (size_t ir = 0; ir < rows; ir += MR) {                                      \
+        size_t mr = MIN((size_t)MR, rows - ir);                                     \
+        for (size_t p = 0; p < kc; p++) {                                           \
+            for (size_t i = 0; i < mr; i++) {                                       \
+                out[i] = a[(ir + i) * lda + p];                                     \
+            }                                                                       \
+            for (size_t i = mr; i < MR; i++) {                                      \
+                out[i] = 0;                                                         \
+            }                                                                       \
+            out += MR;                                                              \
+        }                                                                           \
+    }                                                                               \
+}
+
+// B的kc行×cols列打包为宽NR的列条，列条内按行连续存放，不足NR的部分补0
+#define GEMM_DEFINE_PACK_B(suffix, type, NR)                                        \
+static void gemm_pack_b_##suffix(size_t cols, size_t kc, const void* src, size_t ldb, \
+                                 void* dest) {                                      \
+    const type* b = (const type*)src;                                               \
+    type* out = (type*)dest;                                                        \
+    for (size_t jr = 0; jr < cols; jr += NR) {                                      \
+        size_t nr = MIN((size_t)NR, cols - jr);                                     \
+        for (size_t p = 0; p < kc; p++) {                                           \
+            const type* row = b + p * ldb + jr;                                     \
+            for (size_t j = 0; j < nr; j++) {                                       \
+                out[j] = row[j];                                                    \
+            }                                                                       \
+            for (size_t j = nr; j < NR; j++) {                                      \
+                out[j] = 0;                                                         \
+            }                                                                       \
+            out += NR;                                                              \
+        }                                                                           \
+    }                                                                               \
+}
+
+// c = tile + beta * c；beta为0时不读取c（c中可能是NaN）
+#define GEMM_DEFINE_MERGE(suffix, type)                                             \
+static void gemm_merge_##suffix(size_t mr, size_t nr, const void* tile_data,        \
+                                size_t tile_ld, void* c_data, size_t ldc,           \
+                                double beta) {                                      \
+    const type* tile = (const type*)tile_data;                                      \
+    type* c = (type*)c_data;                                                        \
+    type beta_value = (type)beta;                                                   \
+    for (size_t i = 0; i < mr; i++) {                                               \
+        for (size_t j = 0; j < nr; j++) {                                           \
+            type value = tile[i * tile_ld + j];                                     \
+            c[i * ldc + j] = (beta == 0.0) ? value : value + beta_value * c[i * ldc + j]; \
+        }                                                                           \
+    }                                                                               \
+}
+
+#define GEMM_DEFINE_SCALE(suffix, type)                                             \
+static void gemm_scale_##suffix(size_t m, size_t n, void* c_data, size_t ldc,      \
+                                double beta) {                                      \
+    type* c = (type*)c_data;                                                        \
+    for (size_t i = 0; i < m; i++) {                                                \
+        for (size_t j = 0; j < n; j++) {                                            \
+            c[i * ldc + j] = (beta == 0.0) ? (type)0 : (type)beta * c[i * ldc + j]; \
+        }                                                                           \
+    }                                                                               \
+}
+
+// 通用微内核：计算完整的MR×NR块，内层循环由编译器向量化
+#define GEMM_DEFINE_GENERIC_KERNEL(suffix, type, MR, NR)                            \
+static void gemm_kernel_##suffix##_generic(size_t kc, const void* a_data,           \
+                                           const void* b_data, void* c_data,        \
+                                           size_t ldc, double alpha, double beta) { \
+    const type* a = (const type*)a_data;                                            \
+    const type* b = (const type*)b_data;                                            \
+    type* c = (type*)c_data;                                                        \
+    type acc[MR][NR];                                                               \
+    memset(acc, 0, sizeof(acc));                                                    \
+    for (size_t p = 0; p < kc; p++) {                                               \
+        for (size_t i = 0; i < MR; i++) {                                           \
+            type a_value = a[p * MR + i];                                           \
+            for (size_t j = 0; j < NR; j++) {                                       \
+                acc[i][j] += a_value * b[p * NR + j];                               \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+    for (size_t i = 0; i < MR; i++) {                                               \
+        for (size_t j = 0; j < NR; j++) {                                           \
+            type value = (type)alpha * acc[i][j];                                   \
+            c[i * ldc + j] = (beta == 0.0) ? value : value + (type)beta * c[i * ldc + j]; \
+        }                                                                           \
+    }                                                                               \
+}
+
+GEMM_DEFINE_PACK_A(f32, float, GEMM_F32_MR)
+GEMM_DEFINE_PACK_B(f32, float, GEMM_F32_NR)
+GEMM_DEFINE_MERGE(f32, float)
+GEMM_DEFINE_SCALE(f32, float)
+GEMM_DEFINE_GENERIC_KERNEL(f32, float, GEMM_F32_MR, GEMM_F32_NR)
+
+GEMM_DEFINE_PACK_A(f64, double, GEMM_F64_MR)
+GEMM_DEFINE_PACK_B(f64, double, GEMM_F64_NR)
+GEMM_DEFINE_MERGE(f64, double)
+GEMM_DEFINE_SCALE(f64, double)
+GEMM_DEFINE_GENERIC_KERNEL(f64, double, GEMM_F64_MR, GEMM_F64_NR)
+
+// ============================================================================
+// AVX2/FMA微内核
+// ============================================================================
+
+#if defined(UTILS_ARCH_X86)
+
+// 写回一行累加结果：beta为0时不读取c
+#define GEMM_STORE_PS(ptr, acc)                                                     \
+    _mm256_storeu_ps((ptr), use_beta                                                \
+        ? _mm256_fmadd_ps((acc), alpha_v, _mm256_mul_ps(_mm256_loadu_ps(ptr), beta_v)) \
+        : _mm256_mul_ps((acc), alpha_v))
+
+#define GEMM_STORE_PD(ptr, acc)                                                     \
+    _mm256_storeu_pd((ptr), use_beta                                                \
+        ? _mm256_fmadd_pd((acc), alpha_v, _mm256_mul_pd(_mm256_loadu_pd(ptr), beta_v)) \
+        : _mm256_mul_pd((acc), alpha_v))
+
+// 6×16 float块：12个累加寄存器 + 2个B寄存器 + 1个广播寄存器
+UTILS_TARGET_AVX2_FMA
+static void gemm_kernel_f32_avx2(size_t kc, const void* a_data, const void* b_data, void* c_data,
+                                 size_t ldc, double alpha, double beta) {
+    const float* a = (const float*)a_data;
+    const float* b = (const float*)b_data;
+    float* c = (float*)c_data;
+
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+    for (size_t p = 0; p < kc; p++) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+        __m256 av;
+
+        av = _mm256_broadcast_ss(a + 0);
+        c00 = _mm256_fmadd_ps(av, b0, c00);
+        c01 = _mm256_fmadd_ps(av, b1, c01);
+        av = _mm256_broadcast_ss(a + 1);
+        c10 = _mm256_fmadd_ps(av, b0, c10);
+        c11 = _mm256_fmadd_ps(av, b1, c11);
+        av = _mm256_broadcast_ss(a + 2);
+        c20 = _mm256_fmadd_ps(av, b0, c20);
+        c21 = _mm256_fmadd_ps(av, b1, c21);
+        av = _mm256_broadcast_ss(a + 3);
+        c30 = _mm256_fmadd_ps(av, b0, c30);
+        c31 = _mm256_fmadd_ps(av, b1, c31);
+        av = _mm256_broadcast_ss(a + 4);
+        c40 = _mm256_fmadd_ps(av, b0, c40);
+        c41 = _mm256_fmadd_ps(av, b1, c41);
+        av = _mm256_broadcast_ss(a + 5);
+        c50 = _mm256_fmadd_ps(av, b0, c50);
+        c51 = _mm256_fmadd_ps(av, b1, c51);
+
+        a += GEMM_F32_MR;
+        b += GEMM_F32_NR;
+    }
+
+    __m256 alpha_v = _mm256_set1_ps((float)alpha);
+    __m256 beta_v = _mm256_set1_ps((float)beta);
+    bool use_beta = (beta != 0.0);
+
+    GEMM_STORE_PS(c + 0 * ldc, c00); GEMM_STORE_PS(c + 0 * ldc + 8, c01);
+    GEMM_STORE_PS(c + 1 * ldc, c10); GEMM_STORE_PS(c + 1 * ldc + 8, c11);
+    GEMM_STORE_PS(c + 2 * ldc, c20); GEMM_STORE_PS(c + 2 * ldc + 8, c21);
+    GEMM_STORE_PS(c + 3 * ldc, c30); GEMM_STORE_PS(c + 3 * ldc + 8, c31);
+    GEMM_STORE_PS(c + 4 * ldc, c40); GEMM_STORE_PS(c + 4 * ldc + 8, c41);
+    GEMM_STORE_PS(c + 5 * ldc, c50); GEMM_STORE_PS(c + 5 * ldc + 8, c51);
+}
+
+// 6×8 double块
+UTILS_TARGET_AVX2_FMA
+static void gemm_kernel_f64_avx2(size_t kc, const void* a_data, const void* b_data, void* c_data,
+                                 size_t ldc, double alpha, double beta) {
+    const double* a = (const double*)a_data;
+    const double* b = (const double*)b_data;
+    double* c = (double*)c_data;
+
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+    for (size_t p = 0; p < kc; p++) {
+        __m256d b0 = _mm256_loadu_pd(b);
+        __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d av;
+
+        av = _mm256_broadcast_sd(a + 0);
+        c00 = _mm256_fmadd_pd(av, b0, c00);
+        c01 = _mm256_fmadd_pd(av, b1, c01);
+        av = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(av, b0, c10);
+        c11 = _mm256_fmadd_pd(av, b1, c11);
+        av = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(av, b0, c20);
+        c21 = _mm256_fmadd_pd(av, b1, c21);
+        av = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(av, b0, c30);
+        c31 = _mm256_fmadd_pd(av, b1, c31);
+        av = _mm256_broadcast_sd(a + 4);
+        c40 = _mm256_fmadd_pd(av, b0, c40);
+        c41 = _mm256_fmadd_pd(av, b1, c41);
+        av = _mm256_broadcast_sd(a + 5);
+        c50 = _mm256_fmadd_pd(av, b0, c50);
+        c51 = _mm256_fmadd_pd(av, b1, c51);
+
+        a += GEMM_F64_MR;
+        b += GEMM_F64_NR;
+    }
+
+    __m256d alpha_v = _mm256_set1_pd(alpha);
+    __m256d beta_v = _mm256_set1_pd(beta);
+    bool use_beta = (beta != 0.0);
+
+    GEMM_STORE_PD(c + 0 * ldc, c00); GEMM_STORE_PD(c + 0 * ldc + 4, c01);
+    GEMM_STORE_PD(c + 1 * ldc, c10); GEMM_STORE_PD(c + 1 * ldc + 4, c11);
+    GEMM_STORE_PD(c + 2 * ldc, c20); GEMM_STORE_PD(c + 2 * ldc + 4, c21);
+    GEMM_STORE_PD(c + 3 * ldc, c30); GEMM_STORE_PD(c + 3 * ldc + 4, c31);
+    GEMM_STORE_PD(c + 4 * ldc, c40); GEMM_STORE_PD(c + 4 * ldc + 4, c41);
+    GEMM_STORE_PD(c + 5 * ldc, c50); GEMM_STORE_PD(c + 5 * ldc + 4, c51);
+}
+
+#endif // UTILS_ARCH_X86
+
+static GemmImpl gemm_impl_f32 = {
+    sizeof(float), GEMM_F32_MR, GEMM_F32_NR,
+    gemm_pack_a_f32, gemm_pack_b_f32, gemm_kernel_f32_generic, gemm_merge_f32, gemm_scale_f32
+};
+
+static GemmImpl gemm_impl_f64 = {
+    sizeof(double), GEMM_F64_MR, GEMM_F64_NR,
+    gemm_pack_a_f64, gemm_pack_b_f64, gemm_kernel_f64_generic, gemm_merge_f64, gemm_scale_f64
+};
+
+static UtilsOnce gemm_select_once = UTILS_ONCE_INIT;
+
+static void gemm_select_kernels(void) {
+#if defined(UTILS_ARCH_X86)
+    if (cpu_has_features(CPU_FEATURE_AVX2 | CPU_FEATURE_FMA)) {
+        gemm_impl_f32.kernel = gemm_kernel_f32_avx2;
+        gemm_impl_f64.kernel = gemm_kernel_f64_avx2;
+    }
+#endif
+}
+
+// ============================================================================
+// 分块驱动
+// ============================================================================
+
+typedef struct {
+    const GemmImpl* impl;
+    const char* a;
+    size_t lda;
+    const char* packed_b;
+    char* c;
+    size_t ldc;
+    char* packed_a;             // 每个工作线程GEMM_MC×GEMM_KC个元素
+    size_t m;
+    size_t nc;
+    size_t kc;
+    double alpha;
+    double beta;
+} GemmBlockTask;
+
+static void gemm_ic_blocks(size_t begin, size_t end, size_t worker_index, void* ctx) {
+    const GemmBlockTask* task = (const GemmBlockTask*)ctx;
+    const GemmImpl* impl = task->impl;
+    size_t element = impl->element_size;
+    char* packed_a = task->packed_a + worker_index * GEMM_MC * GEMM_KC * element;
+    double tile[GEMM_MAX_TILE];
+
+    for (size_t block = begin; block < end; block++) {
+        size_t ic = block * GEMM_MC;
+        size_t mc = MIN((size_t)GEMM_MC, task->m - ic);
+
+        impl->pack_a(mc, task->kc, task->a + ic * task->lda * element, task->lda, packed_a);
+
+        for (size_t jr = 0; jr < task->nc; jr += impl->nr) {
+            size_t nr = MIN(impl->nr, task->nc - jr);
+            const char* b_panel = task->packed_b + jr * task->kc * element;
+
+            for (size_t ir = 0; ir < mc; ir += impl->mr) {
+                size_t mr = MIN(impl->mr, mc - ir);
+                const char* a_panel = packed_a + ir * task->kc * element;
+                char* c_block = task->c + ((ic + ir) * task->ldc + jr) * element;
+
+                if (mr == impl->mr && nr == impl->nr) {
+                    impl->kernel(task->kc, a_panel, b_panel, c_block, task->ldc, task->alpha, task->beta);
+                } else {
+                    // 边缘块先算到临时缓冲区，再只写回有效部分
+                    impl->kernel(task->kc, a_panel, b_panel, tile, impl->nr, task->alpha, 0.0);
+                    impl->merge(mr, nr, tile, impl->nr, c_block, task->ldc, task->beta);
+                }
+            }
+        }
+    }
+}
+
+static Status gemm_run(const GemmImpl* impl, ThreadPool* pool, size_t m, size_t n, size_t k,
+                       double alpha, const void* a, size_t lda, const void* b, size_t ldb,
+                       double beta, void* c, size_t ldc) {
+    if (m == 0 || n == 0) {
+        return STATUS_SUCCESS;
+    }
+    if (!c || ldc < n || (k > 0 && (!a || !b || lda < k || ldb < n))) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (k == 0 || alpha == 0.0) {
+        impl->scale(m, n, c, ldc, beta);
+        return STATUS_SUCCESS;
+    }
+
+    utils_call_once(&gemm_select_once, gemm_select_kernels);
+
+    size_t element = impl->element_size;
+    size_t workers = thread_pool_concurrency(pool);
+    size_t nc_max = MIN((size_t)GEMM_NC, n);
+    size_t panel_cols = (nc_max + impl->nr - 1) / impl->nr * impl->nr;
+    char* packed_b = (char*)malloc(GEMM_KC * panel_cols * element);
+    char* packed_a = (char*)malloc(workers * GEMM_MC * GEMM_KC * element);
+    if (!packed_b || !packed_a) {
+        free(packed_b);
+        free(packed_a);
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    Status status = STATUS_SUCCESS;
+    size_t ic_blocks = (m + GEMM_MC - 1) / GEMM_MC;
+
+    for (size_t jc = 0; jc < n && status == STATUS_SUCCESS; jc += GEMM_NC) {
+        size_t nc = MIN((size_t)GEMM_NC, n - jc);
+
+        for (size_t pc = 0; pc < k && status == STATUS_SUCCESS; pc += GEMM_KC) {
+            size_t kc = MIN((size_t)GEMM_KC, k - pc);
+
+            impl->pack_b(nc, kc, (const char*)b + (pc * ldb + jc) * element, ldb, packed_b);
+
+            GemmBlockTask task;
+            task.impl = impl;
+            task.a = (const char*)a + pc * element;
+            task.lda = lda;
+            task.packed_b = packed_b;
+            task.c = (char*)c + jc * element;
+            task.ldc = ldc;
+            task.packed_a = packed_a;
+            task.m = m;
+            task.nc = nc;
+            task.kc = kc;
+            task.alpha = alpha;
+            // 只有第一段k累加时应用beta，之后在已有结果上继续累加
+            task.beta = (pc == 0) ? beta : 1.0;
+
+            status = thread_pool_parallel_for(pool, ic_blocks, 1, gemm_ic_blocks, &task);
+        }
+    }
+
+    free(packed_a);
+    free(packed_b);
+    return status;
+}
+
+Status gemm_f32(ThreadPool* pool, size_t m, size_t n, size_t k,
+                float alpha, const float* a, size_t lda, const float* b, size_t ldb,
+                float beta, float* c, size_t ldc) {
+    return gemm_run(&gemm_impl_f32, pool, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+Status gemm_f64(ThreadPool* pool, size_t m, size_t n, size_t k,
+                double alpha, const double* a, size_t lda, const double* b, size_t ldb,
+                double beta, double* c, size_t ldc) {
+    return gemm_run(&gemm_impl_f64, pool, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+const char* gemm_kernel_name(void) {
+    utils_call_once(&gemm_select_once, gemm_select_kernels);
+#if defined(UTILS_ARCH_X86)
+    if (gemm_impl_f64.kernel == gemm_kernel_f64_avx2) {
+        return "avx2-fma";
+    }
+#endif
+    return "generic";
+}
@@ -0,0 +1,149 @@
+#include "utils.h"
+
+// ============================================================================
+// 快速整数格式化
+//
+// 先数出位数，再从末尾开始每次查表写两位数字，避免snprintf的格式串解析、
+// locale处理和逐位除法。
+// ============================================================================
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static size_t count_digits_u32(uint32_t value) {
+    if (value < 10) return 1;
+    if (value < 100) return 2;
+    if (value < 1000) return 3;
+    if (value < 10000) return 4;
+    if (value < 100000) return 5;
+    if (value < 1000000) return 6;
+    if (value < 10000000) return 7;
+    if (value < 100000000) return 8;
+    if (value < 1000000000) return 9;
+    return 10;
+}
+
+static size_t count_digits_u64(uint64_t value) {
+    size_t digits = 1;
+    while (value >= 100000000) {
+        value /= 100000000;
+        digits += 8;
+    }
+    return digits - 1 + count_digits_u32((uint32_t)value);
+}
+
+// 从end向前写入value的十进制表示，end指向最后一位之后
+static void write_digits_u32(uint32_t value, char* end) {
+    while (value >= 100) {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        uint32_t pair = value * 2;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    } else {
+        *--end = (char)('0' + value);
+    }
+}
+
+size_t format_uint32(uint32_t value, char* out) {
+    size_t length = count_digits_u32(value);
+    write_digits_u32(value, out + length);
+    return length;
+}
+
+size_t format_int32(int32_t value, char* out) {
+    if (value < 0) {
+        *out = '-';
+        return 1 + format_uint32(0u - (uint32_t)value, out + 1);
+    }
+    return format_uint32((uint32_t)value, out);
+}
+
+size_t format_uint64(uint64_t value, char* out) {
+    if (value <= UINT32_MAX) {
+        return format_uint32((uint32_t)value, out);
+    }
+
+    size_t length = count_digits_u64(value);
+    char* end = out + length;
+
+    // 每次取低8位用32位运算输出，减少64位除法次数
+    while (value > UINT32_MAX) {
+        uint32_t low = (uint32_t)(value % 100000000);
+        value /= 100000000;
+        for (int i = 0; i < 4; i++) {
+            uint32_t pair = (low % 100) * 2;
+            low /= 100;
+            *--end = digit_pairs[pair + 1];
+            *--end = digit_pairs[pair];
+        }
+    }
+    write_digits_u32((uint32_t)value, end);
+
+    return length;
+}
+
+size_t format_int64(int64_t value, char* out) {
+    if (value < 0) {
+        *out = '-';
+        return 1 + format_uint64(0u - (uint64_t)value, out + 1);
+    }
+    return format_uint64((uint64_t)value, out);
+}
+
+Status format_int_array(const int* values, size_t count, char delimiter,
+                        char* buffer, size_t buffer_size, size_t* length) {
+    if (!values || !buffer || buffer_size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t needed = (i > 0) ? 1 : 0;
+
+        // 剩余空间足够放下最长的数字时直接写入，否则先写到临时缓冲区检查长度
+        if (buffer_size - pos > UTILS_INT32_MAX_CHARS + 1) {
+            if (i > 0) {
+                buffer[pos++] = delimiter;
+            }
+            pos += format_int32(values[i], buffer + pos);
+            continue;
+        }
+
+        char digits[UTILS_INT32_MAX_CHARS];
+        size_t digit_count = format_int32(values[i], digits);
+        needed += digit_count;
+        if (needed >= buffer_size - pos) {
+            buffer[pos] = '\0';
+            if (length) {
+                *length = pos;
+            }
+            return STATUS_ERROR;
+        }
+
+        if (i > 0) {
+            buffer[pos++] = delimiter;
+        }
+        memcpy(buffer + pos, digits, digit_count);
+        pos += digit_count;
+    }
+
+    buffer[pos] = '\0';
+    if (length) {
+        *length = pos;
+    }
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,148 @@
+#include "utils_internal.h"
+
+// ============================================================================
+// 批量整数解析
+//
+// 直接扫描原始缓冲区（read_file_content的结果或mmap视图），不需要先切分成
+// 以'\0'结尾的字符串，也不经过strtol的locale处理。数字串长度用SSE2一次
+// 校验16个字符，8位以上的数字用SWAR一次转换8位。
+// 溢出检查与safe_string_to_int一致：结果必须落在[INT_MIN, INT_MAX]内。
+// ============================================================================
+
+static bool is_delimiter(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';';
+}
+
+// 返回从p开始的连续数字个数
+static size_t scan_digits(const char* p, const char* end) {
+    const char* start = p;
+
+#ifdef UTILS_HAVE_SSE2
+    const __m128i below = _mm_set1_epi8('0');
+    const __m128i above = _mm_set1_epi8('9');
+
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        // 有符号比较：>=0x80的字节为负数，同样被判为非数字
+        __m128i bad = _mm_or_si128(_mm_cmplt_epi8(chunk, below), _mm_cmpgt_epi8(chunk, above));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(bad);
+        if (mask != 0) {
+            return (size_t)(p - start) + utils_ctz32(mask);
+        }
+        p += 16;
+    }
+#endif
+
+    while (p < end && *p >= '0' && *p <= '9') {
+        p++;
+    }
+    return (size_t)(p - start);
+}
+
+// 一次把8个ASCII数字转换为整数（小端序SWAR）
+static uint32_t parse_eight_digits(const char* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    uint32_t result = 0;
+    for (int i = 0; i < 8; i++) {
+        result = result * 10 + (uint32_t)(p[i] - '0');
+    }
+    (void)value;
+    return result;
+#else
+    // 相邻的1位、2位、4位数字逐级合并
+    value = ((value & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    value = ((value & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return (uint32_t)(((value & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+#endif
+}
+
+// 转换已校验过的数字串，超过int范围时返回false
+static bool convert_digits(const char* p, size_t count, bool negative, int* out) {
+    // 去掉前导零，保证有效位数不超过10时才可能在范围内
+    while (count > 1 && *p == '0') {
+        p++;
+        count--;
+    }
+    if (count > 10) {
+        return false;
+    }
+
+    uint64_t value = 0;
+    if (count >= 8) {
+        size_t head = count - 8;
+        for (size_t i = 0; i < head; i++) {
+            value = value * 10 + (uint64_t)(p[i] - '0');
+        }
+        value = value * 100000000ULL + parse_eight_digits(p + head);
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            value = value * 10 + (uint64_t)(p[i] - '0');
+        }
+    }
+
+    if (negative) {
+        if (value > (uint64_t)INT32_MAX + 1) {
+            return false;
+        }
+        *out = (int)(0 - (int64_t)value);
+    } else {
+        if (value > (uint64_t)INT32_MAX) {
+            return false;
+        }
+        *out = (int)value;
+    }
+    return true;
+}
+
+Status parse_int_array(const char* data, size_t length, int* values, size_t capacity,
+                       size_t* count, size_t* error_offset) {
+    if (!data || !values || !count) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    const char* p = data;
+    const char* end = data + length;
+    size_t parsed = 0;
+    Status status = STATUS_SUCCESS;
+
+    for (;;) {
+        while (p < end && is_delimiter(*p)) {
+            p++;
+        }
+        if (p >= end) {
+            break;
+        }
+
+        const char* token = p;
+        bool negative = false;
+        if (*p == '-' || *p == '+') {
+            negative = (*p == '-');
+            p++;
+        }
+
+        size_t digits = scan_digits(p, end);
+        int value = 0;
+        if (digits == 0 || (p + digits < end && !is_delimiter(p[digits])) ||
+            !convert_digits(p, digits, negative, &value)) {
+            status = STATUS_ERROR;
+        } else if (parsed == capacity) {
+            status = STATUS_OUT_OF_MEMORY;
+        }
+
+        if (status != STATUS_SUCCESS) {
+            if (error_offset) {
+                *error_offset = (size_t)(token - data);
+            }
+            break;
+        }
+
+        values[parsed++] = value;
+        p += digits;
+    }
+
+    *count = parsed;
+    return status;
+}
@@ -13,6 +13,31 @@ void multi_param_callback(int a, float b, char c) {
     printf("Multi-param callback: int=%d, float=%.2f, char='%c'\n", a, b, c);
 }
 
+// 批量回调示例：整块求和后累加到分片计数器（可被多个线程同时调用）
+void sum_chunk_callback(const int* chunk, size_t count, void* ctx) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += chunk[i];
+    }
+    sharded_counter_add((ShardedCounter*)ctx, sum);
+}
+
+// 流水线阶段示例：把整数缓冲区中的每个值加倍
+Status double_values_stage(void* data, size_t size) {
+    int* values = (int*)data;
+    for (size_t i = 0; i < size / sizeof(int); i++) {
+        values[i] *= 2;
+    }
+    return STATUS_SUCCESS;
+}
+
+// 流水线回收示例：释放最后一个阶段处理完的缓冲区
+void free_buffer_release(void* data, size_t size, void* ctx) {
+    (void)size;
+    (void)ctx;
+    free(data);
+}
+
 // 比较函数示例
 int reverse_compare(const void* a, const void* b) {
     int ia = *(const int*)a;
@@ -150,6 +175,15 @@ int main(void) {
     int test_matrix[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
     printf("     multidim_array_param(matrix) = %d\n", multidim_array_param(test_matrix));
     
+    // 同一个3x3矩阵的平方，用通用矩阵乘法计算
+    double gemm_a[9], gemm_c[9];
+    for (int i = 0; i < 9; i++) {
+        gemm_a[i] = test_matrix[i / 3][i % 3];
+    }
+    gemm_f64(NULL, 3, 3, 3, 1.0, gemm_a, 3, gemm_a, 3, 0.0, gemm_c, 3);
+    printf("     gemm_f64(matrix * matrix) first row = %.0f %.0f %.0f (kernel: %s)\n",
+           gemm_c[0], gemm_c[1], gemm_c[2], gemm_kernel_name());
+    
     // 函数指针参数测试
     printf("   Function Pointer Parameters:\n");
     printf("     function_pointer_param_1(square_func) = %d\n", function_pointer_param_1(single_int_param));
@@ -346,6 +380,22 @@ int main(void) {
         safe_free(&ptr);
         printf("   safe_free: %s\n", ptr ? "Failed" : "Success");
     }
+
+    Arena* arena = arena_create(0);
+    if (arena) {
+        ArenaMark mark = arena_mark(arena);
+        Person* arena_person = arena_create_person(arena, "Carol", 35, 160.0f, 50.5);
+        LinkedList* arena_list = arena_create_linked_list(arena);
+        if (arena_person && arena_list) {
+            add_node(arena_list, 1);
+            add_node(arena_list, 2);
+            printf("   arena_create_person: %s, arena list count: %zu\n",
+                   arena_person->name, arena_list->count);
+        }
+        arena_reset_to_mark(arena, mark);
+        arena_destroy(arena);
+        printf("   arena_destroy: Success\n");
+    }
     printf("\n");
     
     // ========================================================================
@@ -386,8 +436,43 @@ int main(void) {
     result = process_array(callback_array, array_size, print_callback);
     printf("   process_array result: %d\n", result);
     
+    ShardedCounter array_sum = SHARDED_COUNTER_INIT(0);
+    result = process_array_batched(callback_array, array_size, 4, sum_chunk_callback, &array_sum);
+    printf("   process_array_batched sum: %lld, result: %d\n",
+           (long long)sharded_counter_read(&array_sum), result);
+    
+    ThreadPool* sum_pool = thread_pool_create(0);
+    sharded_counter_init(&array_sum, 0);
+    result = process_array_parallel(sum_pool, callback_array, array_size, 2, sum_chunk_callback, &array_sum);
+    printf("   process_array_parallel sum: %lld, result: %d\n",
+           (long long)sharded_counter_read(&array_sum), result);
+    thread_pool_destroy(sum_pool);
+    
     result = generic_processor(callback_array, sizeof(callback_array), data_processor);
     printf("   generic_processor result: %d\n", result);
+    
+    Pipeline* pipeline = pipeline_create(4, free_buffer_release, NULL);
+    if (pipeline) {
+        pipeline_add_stage(pipeline, double_values_stage);
+        pipeline_add_stage(pipeline, data_processor);
+        result = pipeline_start(pipeline);
+        for (int batch = 0; batch < 2 && result == STATUS_SUCCESS; batch++) {
+            int* buffer = (int*)malloc(array_size * sizeof(int));
+            if (!buffer) {
+                break;
+            }
+            memcpy(buffer, callback_array, array_size * sizeof(int));
+            pipeline_submit(pipeline, buffer, array_size * sizeof(int));
+        }
+        result = pipeline_finish(pipeline);
+        
+        printf("   pipeline result: %d\n", result);
+        PipelineStageStats stage_stats = {0};
+        if (pipeline_get_stage_stats(pipeline, 0, &stage_stats) == STATUS_SUCCESS) {
+            printf("   stage 0 processed %llu buffers\n", (unsigned long long)stage_stats.items);
+        }
+        pipeline_destroy(pipeline);
+    }
     printf("\n");
     
     // ========================================================================
@@ -399,6 +484,15 @@ int main(void) {
     
     result = print_formatted("    Formatted output: %s = %d, %.2f\n", "PI", 3, 3.14159);
     printf("    print_formatted result: %d\n", result);
+    
+    OutputBuffer out;
+    if (output_buffer_init(&out, 0) == STATUS_SUCCESS) {
+        Person people[2] = { person1, person2 };
+        print_formatted_to_buffer(&out, "    Buffered output: %s = %d\n", "PI", 3);
+        print_persons_to_buffer(people, 2, &out);
+        output_buffer_flush_file(&out, stdout);
+        output_buffer_free(&out);
+    }
     printf("\n");
     
     // ========================================================================
@@ -417,12 +511,37 @@ int main(void) {
         printf("\n");
     }
     
+    // 10x10情况下与complex_nested_loops的结果逐元素对照
+    IntMatrix int_matrix;
+    if (int_matrix_create(&int_matrix, 10, 10) == STATUS_SUCCESS) {
+        int64_t matrix_sum = 0;
+        int mismatches = 0;
+        int_matrix_fill_index_and_reduce(&int_matrix, &matrix_sum);
+        complex_nested_loops(matrix, 10, 10);
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 10; j++) {
+                mismatches += (INT_MATRIX_AT(&int_matrix, i, j) != matrix[i][j]);
+            }
+        }
+        printf("    int_matrix 10x10 fill-and-reduce sum: %lld, mismatches: %d\n",
+               (long long)matrix_sum, mismatches);
+        int_matrix_destroy(&int_matrix);
+    }
+    
     int goto_array[] = {1, 2, 3, 4, 5};
     result = goto_example(goto_array, 5, 3);
     printf("    goto_example(target=3) result: %d\n", result);
     
     result = nested_switch_if(10, 5, '+');
     printf("    nested_switch_if(10, 5, '+') result: %d\n", result);
+    
+    int batch_a[] = {10, 3, 4, 1};
+    int batch_b[] = {5, 7, 6, 1};
+    char batch_ops[] = {'+', '-', '*', '/'};
+    Status batch_results[4];
+    nested_switch_if_batch(batch_a, batch_b, batch_ops, 4, batch_results);
+    printf("    nested_switch_if_batch results: %d %d %d %d\n",
+           batch_results[0], batch_results[1], batch_results[2], batch_results[3]);
     printf("\n");
     
     // ========================================================================
@@ -442,6 +561,23 @@ int main(void) {
     variant.value.i = 42;
     result = variant_data_operations(&variant);
     printf("    variant_data_operations(INT, 42) result: %d, new value: %d\n", result, variant.value.i);
+    
+    Column int_column, string_column;
+    Status int_status = column_init(&int_column, TYPE_INT, 4);
+    Status string_status = column_init(&string_column, TYPE_STRING, 4);
+    if (int_status == STATUS_SUCCESS && string_status == STATUS_SUCCESS) {
+        column_append_int(&int_column, 42);
+        column_append_int(&int_column, -7);
+        column_append_string(&string_column, "hello");
+        column_append_string(&string_column, "asm_x64");
+        column_operations(&int_column);
+        result = column_operations(&string_column);
+        printf("    column_operations result: %d, ints: %d %d, strings: %.8s %.8s\n", result,
+               int_column.values.i[0], int_column.values.i[1],
+               string_column.values.s[0], string_column.values.s[1]);
+    }
+    column_free(&int_column);
+    column_free(&string_column);
     printf("\n");
     
     // ========================================================================
@@ -463,7 +599,7 @@ int main(void) {
     // 测试静态和全局变量
     // ========================================================================
     printf("15. Testing Static and Global Variables:\n");
-    printf("    Initial global_counter: %d\n", global_counter);
+    printf("    Initial global_counter: %d\n", get_global_counter());
     
     increment_global_counter();
     increment_global_counter();
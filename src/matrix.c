@@ -0,0 +1,326 @@
+#include "utils_internal.h"
+
+// ============================================================================
+// 整数矩阵
+//
+// 行主序存储，每行起始地址按64字节对齐（stride向上取整到16个int），使逐行的
+// SIMD读写都从缓存行边界开始。转置按TILE×TILE分块进行，源块和目标块都能
+// 同时留在L1缓存中，块内再用4×4的SSE2寄存器转置。
+// ============================================================================
+
+#define MATRIX_ALIGNMENT 64
+#define MATRIX_STRIDE_MULTIPLE (MATRIX_ALIGNMENT / sizeof(int))
+#define MATRIX_TILE 32
+#define MATRIX_PARALLEL_ROWS 16
+
+Status int_matrix_create(IntMatrix* matrix, size_t rows, size_t cols) {
+    if (!matrix || rows == 0 || cols == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    size_t stride = (cols + MATRIX_STRIDE_MULTIPLE - 1) / MATRIX_STRIDE_MULTIPLE * MATRIX_STRIDE_MULTIPLE;
+    if (stride < cols || rows > (SIZE_MAX - MATRIX_ALIGNMENT) / sizeof(int) / stride) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    void* block = malloc(rows * stride * sizeof(int) + MATRIX_ALIGNMENT);
+    if (!block) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    uintptr_t aligned = ((uintptr_t)block + MATRIX_ALIGNMENT - 1) & ~(uintptr_t)(MATRIX_ALIGNMENT - 1);
+    matrix->data = (int*)aligned;
+    matrix->block = block;
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->stride = stride;
+    return STATUS_SUCCESS;
+}
+
+void int_matrix_destroy(IntMatrix* matrix) {
+    if (!matrix) {
+        return;
+    }
+
+    free(matrix->block);
+    matrix->block = NULL;
+    matrix->data = NULL;
+    matrix->rows = 0;
+    matrix->cols = 0;
+    matrix->stride = 0;
+}
+
+// ============================================================================
+// 行内核
+// ============================================================================
+
+// 写入row[j] = first + j（按32位回绕，与int运算溢出时的实际结果一致）
+static void row_fill_sequence(int* row, size_t cols, uint32_t first) {
+    size_t j = 0;
+
+#if defined(UTILS_HAVE_AVX2)
+    __m256i values = _mm256_add_epi32(_mm256_set1_epi32((int)first),
+                                      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    const __m256i step = _mm256_set1_epi32(8);
+    for (; j + 8 <= cols; j += 8) {
+        _mm256_storeu_si256((__m256i*)(row + j), values);
+        values = _mm256_add_epi32(values, step);
+    }
+#elif defined(UTILS_HAVE_SSE2)
+    __m128i values = _mm_add_epi32(_mm_set1_epi32((int)first), _mm_setr_epi32(0, 1, 2, 3));
+    const __m128i step = _mm_set1_epi32(4);
+    for (; j + 4 <= cols; j += 4) {
+        _mm_storeu_si128((__m128i*)(row + j), values);
+        values = _mm_add_epi32(values, step);
+    }
+#endif
+
+    for (; j < cols; j++) {
+        row[j] = (int)(first + (uint32_t)j);
+    }
+}
+
+static void row_fill_value(int* row, size_t cols, int value) {
+    size_t j = 0;
+
+#if defined(UTILS_HAVE_SSE2)
+    const __m128i values = _mm_set1_epi32(value);
+    for (; j + 4 <= cols; j += 4) {
+        _mm_storeu_si128((__m128i*)(row + j), values);
+    }
+#endif
+
+    for (; j < cols; j++) {
+        row[j] = value;
+    }
+}
+
+// 行求和，同时统计偶数个数（count_even为NULL时不统计）
+static int64_t row_sum(const int* row, size_t cols, int64_t* count_even) {
+    int64_t sum = 0;
+    int64_t evens = 0;
+    size_t j = 0;
+
+#if defined(UTILS_HAVE_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+    __m256i even_acc = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    for (; j + 8 <= cols; j += 8) {
+        __m256i values = _mm256_loadu_si256((const __m256i*)(row + j));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1)));
+        // 偶数标记按32位通道累加，每个通道每次最多加1，一行内不会溢出
+        even_acc = _mm256_add_epi32(even_acc, _mm256_andnot_si256(values, one));
+    }
+
+    int64_t lanes[4];
+    int32_t even_lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    _mm256_storeu_si256((__m256i*)even_lanes, even_acc);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (int k = 0; k < 8; k++) {
+        evens += (uint32_t)even_lanes[k];
+    }
+#elif defined(UTILS_HAVE_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    __m128i even_acc = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    for (; j + 4 <= cols; j += 4) {
+        __m128i values = _mm_loadu_si128((const __m128i*)(row + j));
+        // SSE2没有32位到64位的符号扩展指令，用符号位拼出高32位
+        __m128i sign = _mm_srai_epi32(values, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(values, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(values, sign));
+        even_acc = _mm_add_epi32(even_acc, _mm_andnot_si128(values, one));
+    }
+
+    int64_t lanes[2];
+    int32_t even_lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    _mm_storeu_si128((__m128i*)even_lanes, even_acc);
+    sum = lanes[0] + lanes[1];
+    for (int k = 0; k < 4; k++) {
+        evens += (uint32_t)even_lanes[k];
+    }
+#endif
+
+    for (; j < cols; j++) {
+        sum += row[j];
+        evens += (row[j] & 1) == 0;
+    }
+
+    if (count_even) {
+        *count_even = evens;
+    }
+    return sum;
+}
+
+// ============================================================================
+// 整体操作
+// ============================================================================
+
+Status int_matrix_fill(IntMatrix* matrix, int value) {
+    if (!matrix || !matrix->data) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    for (size_t i = 0; i < matrix->rows; i++) {
+        row_fill_value(matrix->data + i * matrix->stride, matrix->cols, value);
+    }
+    return STATUS_SUCCESS;
+}
+
+Status int_matrix_fill_index(IntMatrix* matrix) {
+    if (!matrix || !matrix->data) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    for (size_t i = 0; i < matrix->rows; i++) {
+        row_fill_sequence(matrix->data + i * matrix->stride, matrix->cols, (uint32_t)(i * matrix->cols));
+    }
+    return STATUS_SUCCESS;
+}
+
+Status int_matrix_sum(const IntMatrix* matrix, int64_t* sum) {
+    if (!matrix || !matrix->data || !sum) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    int64_t total = 0;
+    for (size_t i = 0; i < matrix->rows; i++) {
+        total += row_sum(matrix->data + i * matrix->stride, matrix->cols, NULL);
+    }
+    *sum = total;
+    return STATUS_SUCCESS;
+}
+
+#if defined(UTILS_HAVE_SSE2)
+// 转置一个4×4块：src行距src_stride，dest行距dest_stride
+static void transpose_4x4(const int* src, size_t src_stride, int* dest, size_t dest_stride) {
+    __m128i r0 = _mm_loadu_si128((const __m128i*)(src));
+    __m128i r1 = _mm_loadu_si128((const __m128i*)(src + src_stride));
+    __m128i r2 = _mm_loadu_si128((const __m128i*)(src + 2 * src_stride));
+    __m128i r3 = _mm_loadu_si128((const __m128i*)(src + 3 * src_stride));
+
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);   // a0 b0 a1 b1
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);   // c0 d0 c1 d1
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);   // a2 b2 a3 b3
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);   // c2 d2 c3 d3
+
+    _mm_storeu_si128((__m128i*)(dest), _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(dest + dest_stride), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i*)(dest + 2 * dest_stride), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i*)(dest + 3 * dest_stride), _mm_unpackhi_epi64(t2, t3));
+}
+#endif
+
+Status int_matrix_transpose(const IntMatrix* src, IntMatrix* dest) {
+    if (!src || !dest || !src->data || !dest->data || src == dest ||
+        dest->rows != src->cols || dest->cols != src->rows) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    size_t rows = src->rows;
+    size_t cols = src->cols;
+
+    for (size_t ii = 0; ii < rows; ii += MATRIX_TILE) {
+        size_t i_end = MIN(ii + MATRIX_TILE, rows);
+        for (size_t jj = 0; jj < cols; jj += MATRIX_TILE) {
+            size_t j_end = MIN(jj + MATRIX_TILE, cols);
+            size_t i = ii;
+
+#if defined(UTILS_HAVE_SSE2)
+            for (; i + 4 <= i_end; i += 4) {
+                size_t j = jj;
+                for (; j + 4 <= j_end; j += 4) {
+                    transpose_4x4(src->data + i * src->stride + j, src->stride,
+                                  dest->data + j * dest->stride + i, dest->stride);
+                }
+                for (; j < j_end; j++) {
+                    for (size_t k = i; k < i + 4; k++) {
+                        dest->data[j * dest->stride + k] = src->data[k * src->stride + j];
+                    }
+                }
+            }
+#endif
+
+            for (; i < i_end; i++) {
+                for (size_t j = jj; j < j_end; j++) {
+                    dest->data[j * dest->stride + i] = src->data[i * src->stride + j];
+                }
+            }
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+// ============================================================================
+// 填充并归约（complex_nested_loops的模式）
+// ============================================================================
+
+// 填充第i行并返回该行按complex_nested_loops规则的和：每个值累加一次，偶数再加0+1+2
+static int64_t fill_and_reduce_row(IntMatrix* matrix, size_t i) {
+    int* row = matrix->data + i * matrix->stride;
+    int64_t evens = 0;
+
+    row_fill_sequence(row, matrix->cols, (uint32_t)(i * matrix->cols));
+    int64_t sum = row_sum(row, matrix->cols, &evens);
+    return sum + evens * 3;
+}
+
+Status int_matrix_fill_index_and_reduce(IntMatrix* matrix, int64_t* sum) {
+    if (!matrix || !matrix->data || !sum) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    int64_t total = 0;
+    for (size_t i = 0; i < matrix->rows; i++) {
+        total += fill_and_reduce_row(matrix, i);
+    }
+    *sum = total;
+    return STATUS_SUCCESS;
+}
+
+typedef struct {
+    IntMatrix* matrix;
+    int64_t* partial_sums;      // 每个工作线程一个缓存行
+} MatrixReduceTask;
+
+#define MATRIX_PARTIAL_STRIDE (UTILS_CACHE_LINE_SIZE / sizeof(int64_t))
+
+static void fill_and_reduce_rows(size_t begin, size_t end, size_t worker_index, void* ctx) {
+    MatrixReduceTask* task = (MatrixReduceTask*)ctx;
+    int64_t sum = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        sum += fill_and_reduce_row(task->matrix, i);
+    }
+    task->partial_sums[worker_index * MATRIX_PARTIAL_STRIDE] += sum;
+}
+
+Status int_matrix_fill_index_and_reduce_parallel(ThreadPool* pool, IntMatrix* matrix, int64_t* sum) {
+    if (!matrix || !matrix->data || !sum) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    size_t workers = thread_pool_concurrency(pool);
+    int64_t* partial_sums = (int64_t*)calloc(workers * MATRIX_PARTIAL_STRIDE, sizeof(int64_t));
+    if (!partial_sums) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    MatrixReduceTask task = { matrix, partial_sums };
+    Status status = thread_pool_parallel_for(pool, matrix->rows, MATRIX_PARALLEL_ROWS,
+                                             fill_and_reduce_rows, &task);
+    if (status == STATUS_SUCCESS) {
+        int64_t total = 0;
+        for (size_t w = 0; w < workers; w++) {
+            total += partial_sums[w * MATRIX_PARTIAL_STRIDE];
+        }
+        *sum = total;
+    }
+
+    free(partial_sums);
+    return status;
+}
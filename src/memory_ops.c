@@ -0,0 +1,210 @@
+#include "utils_internal.h"
+
+#ifdef PLATFORM_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// 大块内存复制和设置
+//
+// 小于阈值时直接使用memcpy/memset；超过阈值时使用非临时流式写入，
+// 目标数据不经过缓存，避免清理/复制GB级缓冲区时把热数据挤出缓存。
+// ============================================================================
+
+// 并行复制时每个任务处理的字节数
+#define MEMORY_PARALLEL_CHUNK (4u * 1024 * 1024)
+
+static size_t memory_streaming_threshold = MEMORY_STREAMING_THRESHOLD_DEFAULT;
+
+typedef struct {
+    char* dest;
+    const char* src;
+    int value;
+    bool streaming;
+} MemoryParallelJob;
+
+static void memory_stream_copy(void* dest, const void* src, size_t size) {
+#ifdef UTILS_HAVE_SSE2
+    char* d = (char*)dest;
+    const char* s = (const char*)src;
+
+    // 先把目标地址对齐到16字节，流式写入要求对齐
+    size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+    if (head > size) {
+        head = size;
+    }
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    size_t blocks = size / 64;
+    for (size_t i = 0; i < blocks; i++) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(s + 0));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(s + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i*)(s + 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i*)(s + 48));
+        _mm_stream_si128((__m128i*)(d + 0), v0);
+        _mm_stream_si128((__m128i*)(d + 16), v1);
+        _mm_stream_si128((__m128i*)(d + 32), v2);
+        _mm_stream_si128((__m128i*)(d + 48), v3);
+        s += 64;
+        d += 64;
+    }
+    _mm_sfence();
+
+    memcpy(d, s, size % 64);
+#else
+    memcpy(dest, src, size);
+#endif
+}
+
+static void memory_stream_set(void* ptr, int value, size_t size) {
+#ifdef UTILS_HAVE_SSE2
+    char* d = (char*)ptr;
+
+    size_t head = (16 - ((uintptr_t)d & 15)) & 15;
+    if (head > size) {
+        head = size;
+    }
+    memset(d, value, head);
+    d += head;
+    size -= head;
+
+    __m128i v = _mm_set1_epi8((char)value);
+    size_t blocks = size / 64;
+    for (size_t i = 0; i < blocks; i++) {
+        _mm_stream_si128((__m128i*)(d + 0), v);
+        _mm_stream_si128((__m128i*)(d + 16), v);
+        _mm_stream_si128((__m128i*)(d + 32), v);
+        _mm_stream_si128((__m128i*)(d + 48), v);
+        d += 64;
+    }
+    _mm_sfence();
+
+    memset(d, value, size % 64);
+#else
+    memset(ptr, value, size);
+#endif
+}
+
+void memory_set_streaming_threshold(size_t bytes) {
+    memory_streaming_threshold = bytes;
+}
+
+size_t memory_get_streaming_threshold(void) {
+    return memory_streaming_threshold;
+}
+
+Status memory_copy_large(void* dest, const void* src, size_t size) {
+    if (!dest || !src || size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    if (size >= memory_streaming_threshold) {
+        memory_stream_copy(dest, src, size);
+    } else {
+        memcpy(dest, src, size);
+    }
+    return STATUS_SUCCESS;
+}
+
+Status memory_set_large(void* ptr, int value, size_t size) {
+    if (!ptr || size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    if (size >= memory_streaming_threshold) {
+        memory_stream_set(ptr, value, size);
+    } else {
+        memset(ptr, value, size);
+    }
+    return STATUS_SUCCESS;
+}
+
+// ============================================================================
+// 并行版本（按MEMORY_PARALLEL_CHUNK切块分给线程池）
+// ============================================================================
+
+static void memory_copy_chunk(size_t begin, size_t end, size_t worker_index, void* ctx) {
+    MemoryParallelJob* job = (MemoryParallelJob*)ctx;
+    (void)worker_index;
+
+    if (job->streaming) {
+        memory_stream_copy(job->dest + begin, job->src + begin, end - begin);
+    } else {
+        memcpy(job->dest + begin, job->src + begin, end - begin);
+    }
+}
+
+static void memory_set_chunk(size_t begin, size_t end, size_t worker_index, void* ctx) {
+    MemoryParallelJob* job = (MemoryParallelJob*)ctx;
+    (void)worker_index;
+
+    if (job->streaming) {
+        memory_stream_set(job->dest + begin, job->value, end - begin);
+    } else {
+        memset(job->dest + begin, job->value, end - begin);
+    }
+}
+
+Status memory_copy_parallel(ThreadPool* pool, void* dest, const void* src, size_t size) {
+    if (!dest || !src || size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    MemoryParallelJob job;
+    job.dest = (char*)dest;
+    job.src = (const char*)src;
+    job.value = 0;
+    job.streaming = size >= memory_streaming_threshold;
+
+    return thread_pool_parallel_for(pool, size, MEMORY_PARALLEL_CHUNK, memory_copy_chunk, &job);
+}
+
+Status memory_set_parallel(ThreadPool* pool, void* ptr, int value, size_t size) {
+    if (!ptr || size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    MemoryParallelJob job;
+    job.dest = (char*)ptr;
+    job.src = NULL;
+    job.value = value;
+    job.streaming = size >= memory_streaming_threshold;
+
+    return thread_pool_parallel_for(pool, size, MEMORY_PARALLEL_CHUNK, memory_set_chunk, &job);
+}
+
+// ============================================================================
+// 整页清零
+// ============================================================================
+
+Status memory_zero_pages(void* ptr, size_t size) {
+    if (!ptr || size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+#ifdef PLATFORM_LINUX
+    // 对整页部分使用MADV_DONTNEED：内核丢弃物理页，下次访问时映射零页，
+    // 不需要逐字节写入。只适用于私有匿名映射（malloc的大块内存、mmap匿名内存）。
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0) {
+        uintptr_t page_mask = (uintptr_t)page_size - 1;
+        uintptr_t begin = (uintptr_t)ptr;
+        uintptr_t end = begin + size;
+        uintptr_t page_begin = (begin + page_mask) & ~page_mask;
+        uintptr_t page_end = end & ~page_mask;
+
+        if (page_end > page_begin &&
+            madvise((void*)page_begin, page_end - page_begin, MADV_DONTNEED) == 0) {
+            memset(ptr, 0, page_begin - begin);
+            memset((void*)page_end, 0, end - page_end);
+            return STATUS_SUCCESS;
+        }
+    }
+#endif
+
+    return memory_set_large(ptr, 0, size);
+}
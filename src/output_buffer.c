@@ -0,0 +1,358 @@
+#include "utils.h"
+#include <stdarg.h>
+#include <math.h>
+
+#ifdef PLATFORM_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// 输出缓冲区
+//
+// 把大量小的格式化输出先拼接到内存中，再用少量大块write/fwrite写出，
+// 避免逐条printf带来的系统调用和stdio锁开销。
+// ============================================================================
+
+static const double pow10_table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+static const uint64_t pow10_int_table[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+    1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+};
+
+static Status output_buffer_maybe_flush(OutputBuffer* buffer) {
+    if (buffer->sink && buffer->length >= buffer->flush_threshold) {
+        return output_buffer_flush_file(buffer, buffer->sink);
+    }
+    return STATUS_SUCCESS;
+}
+
+Status output_buffer_init(OutputBuffer* buffer, size_t initial_capacity) {
+    if (!buffer) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+    buffer->sink = NULL;
+    buffer->flush_threshold = 0;
+
+    return output_buffer_reserve(buffer, (initial_capacity > 0)
+                                 ? initial_capacity : OUTPUT_BUFFER_DEFAULT_CAPACITY);
+}
+
+Status output_buffer_init_sink(OutputBuffer* buffer, FILE* sink, size_t flush_threshold) {
+    if (!sink) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (flush_threshold == 0) {
+        flush_threshold = OUTPUT_BUFFER_DEFAULT_CAPACITY;
+    }
+
+    Status status = output_buffer_init(buffer, flush_threshold + MAX_BUFFER_SIZE);
+    if (status == STATUS_SUCCESS) {
+        buffer->sink = sink;
+        buffer->flush_threshold = flush_threshold;
+    }
+    return status;
+}
+
+void output_buffer_free(OutputBuffer* buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    if (buffer->sink) {
+        output_buffer_flush_file(buffer, buffer->sink);
+    }
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+void output_buffer_clear(OutputBuffer* buffer) {
+    if (buffer) {
+        buffer->length = 0;
+    }
+}
+
+Status output_buffer_reserve(OutputBuffer* buffer, size_t additional) {
+    if (!buffer) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (additional > SIZE_MAX - buffer->length) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    size_t required = buffer->length + additional;
+    if (required <= buffer->capacity) {
+        return STATUS_SUCCESS;
+    }
+
+    size_t new_capacity = (buffer->capacity > 0) ? buffer->capacity : OUTPUT_BUFFER_DEFAULT_CAPACITY;
+    while (new_capacity < required) {
+        new_capacity = (new_capacity > SIZE_MAX / 2) ? required : new_capacity * 2;
+    }
+
+    char* data = (char*)realloc(buffer->data, new_capacity);
+    if (!data) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    buffer->data = data;
+    buffer->capacity = new_capacity;
+    return STATUS_SUCCESS;
+}
+
+Status output_buffer_append(OutputBuffer* buffer, const char* data, size_t length) {
+    if (!buffer || (!data && length > 0)) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    Status status = output_buffer_reserve(buffer, length);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+
+    return output_buffer_maybe_flush(buffer);
+}
+
+Status output_buffer_append_str(OutputBuffer* buffer, const char* str) {
+    if (!str) {
+        return STATUS_INVALID_PARAM;
+    }
+    return output_buffer_append(buffer, str, strlen(str));
+}
+
+Status output_buffer_append_char(OutputBuffer* buffer, char c) {
+    Status status = output_buffer_reserve(buffer, 1);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+
+    buffer->data[buffer->length++] = c;
+    return output_buffer_maybe_flush(buffer);
+}
+
+Status output_buffer_append_int(OutputBuffer* buffer, int64_t value) {
+    Status status = output_buffer_reserve(buffer, UTILS_INT64_MAX_CHARS);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+
+    buffer->length += format_int64(value, buffer->data + buffer->length);
+    return output_buffer_maybe_flush(buffer);
+}
+
+Status output_buffer_append_double(OutputBuffer* buffer, double value, int precision) {
+    if (!buffer || precision < 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    // 常见范围内整数部分和小数部分分别按整数输出；小数部分放大后离".5"过近时
+    // 乘法的舍入误差可能改变进位方向，这种情况与超出范围的值一样交给snprintf
+    double magnitude = fabs(value);
+    if (precision > 9 || !(magnitude < 1e15)) {
+        return output_buffer_printf(buffer, "%.*f", precision, value);
+    }
+
+    double integer_value = floor(magnitude);
+    double scaled_fraction = (magnitude - integer_value) * pow10_table[precision];
+    double fraction_floor = floor(scaled_fraction);
+    if (fabs(scaled_fraction - fraction_floor - 0.5) < 1e-6) {
+        return output_buffer_printf(buffer, "%.*f", precision, value);
+    }
+
+    uint64_t integer_part = (uint64_t)integer_value;
+    uint64_t fraction = (uint64_t)fraction_floor + ((scaled_fraction - fraction_floor > 0.5) ? 1 : 0);
+    if (fraction == pow10_int_table[precision]) {
+        integer_part++;
+        fraction = 0;
+    }
+
+    Status status = output_buffer_reserve(buffer, UTILS_INT64_MAX_CHARS + 12);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+
+    char* out = buffer->data + buffer->length;
+    char* start = out;
+    if (signbit(value)) {
+        *out++ = '-';
+    }
+    out += format_uint64(integer_part, out);
+
+    if (precision > 0) {
+        *out++ = '.';
+        for (int i = precision - 1; i >= 0; i--) {
+            out[i] = (char)('0' + fraction % 10);
+            fraction /= 10;
+        }
+        out += precision;
+    }
+
+    buffer->length += (size_t)(out - start);
+    return output_buffer_maybe_flush(buffer);
+}
+
+static Status output_buffer_vprintf(OutputBuffer* buffer, const char* format, va_list args) {
+    if (!buffer || !format) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    // 先尝试直接写入剩余空间，不够时按所需长度扩容后重写
+    Status status = output_buffer_reserve(buffer, MAX_BUFFER_SIZE);
+    if (status != STATUS_SUCCESS) {
+        return status;
+    }
+
+    va_list retry;
+    va_copy(retry, args);
+
+    size_t available = buffer->capacity - buffer->length;
+    int written = vsnprintf(buffer->data + buffer->length, available, format, args);
+    if (written < 0) {
+        va_end(retry);
+        return STATUS_ERROR;
+    }
+
+    if ((size_t)written >= available) {
+        status = output_buffer_reserve(buffer, (size_t)written + 1);
+        if (status != STATUS_SUCCESS) {
+            va_end(retry);
+            return status;
+        }
+        vsnprintf(buffer->data + buffer->length, (size_t)written + 1, format, retry);
+    }
+    va_end(retry);
+
+    buffer->length += (size_t)written;
+    return output_buffer_maybe_flush(buffer);
+}
+
+Status output_buffer_printf(OutputBuffer* buffer, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    Status status = output_buffer_vprintf(buffer, format, args);
+    va_end(args);
+    return status;
+}
+
+Status output_buffer_flush_file(OutputBuffer* buffer, FILE* stream) {
+    if (!buffer || !stream) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    size_t written = fwrite(buffer->data, 1, buffer->length, stream);
+    if (written != buffer->length) {
+        return STATUS_ERROR;
+    }
+
+    buffer->length = 0;
+    return STATUS_SUCCESS;
+}
+
+Status output_buffer_flush_fd(OutputBuffer* buffer, int fd) {
+    if (!buffer || fd < 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    size_t offset = 0;
+    while (offset < buffer->length) {
+        size_t remaining = buffer->length - offset;
+#ifdef PLATFORM_WINDOWS
+        int chunk = _write(fd, buffer->data + offset, (unsigned int)MIN(remaining, (size_t)INT32_MAX));
+#else
+        ssize_t chunk = write(fd, buffer->data + offset, remaining);
+#endif
+        if (chunk <= 0) {
+            return STATUS_ERROR;
+        }
+        offset += (size_t)chunk;
+    }
+
+    buffer->length = 0;
+    return STATUS_SUCCESS;
+}
+
+// ============================================================================
+// 写入缓冲区的打印函数
+// ============================================================================
+
+Status print_list_to_buffer(const LinkedList* list, OutputBuffer* buffer) {
+    if (!list || !buffer) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    Status status = output_buffer_append_str(buffer, "List (count: ");
+    if (status == STATUS_SUCCESS) {
+        status = output_buffer_append_int(buffer, (int64_t)list->count);
+    }
+    if (status == STATUS_SUCCESS) {
+        status = output_buffer_append(buffer, "): ", 3);
+    }
+
+    Node* current = list->head;
+    while (current && status == STATUS_SUCCESS) {
+        status = output_buffer_append_int(buffer, current->data);
+        if (status == STATUS_SUCCESS) {
+            status = output_buffer_append_char(buffer, ' ');
+        }
+        current = current->next;
+    }
+
+    if (status == STATUS_SUCCESS) {
+        status = output_buffer_append_char(buffer, '\n');
+    }
+    return status;
+}
+
+Status print_person_to_buffer(const Person* person, OutputBuffer* buffer) {
+    if (!person || !buffer) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    Status status = output_buffer_append_str(buffer, "Person: ");
+    if (status == STATUS_SUCCESS) status = output_buffer_append_str(buffer, person->name);
+    if (status == STATUS_SUCCESS) status = output_buffer_append_str(buffer, ", Age: ");
+    if (status == STATUS_SUCCESS) status = output_buffer_append_int(buffer, person->age);
+    if (status == STATUS_SUCCESS) status = output_buffer_append_str(buffer, ", Height: ");
+    if (status == STATUS_SUCCESS) status = output_buffer_append_double(buffer, person->height, 2);
+    if (status == STATUS_SUCCESS) status = output_buffer_append_str(buffer, ", Weight: ");
+    if (status == STATUS_SUCCESS) status = output_buffer_append_double(buffer, person->weight, 2);
+    if (status == STATUS_SUCCESS) status = output_buffer_append_str(buffer, ", Active: ");
+    if (status == STATUS_SUCCESS) status = output_buffer_append_str(buffer, person->is_active ? "Yes\n" : "No\n");
+
+    return status;
+}
+
+Status print_persons_to_buffer(const Person* persons, size_t count, OutputBuffer* buffer) {
+    if (!persons || !buffer) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        Status status = print_person_to_buffer(&persons[i], buffer);
+        if (status != STATUS_SUCCESS) {
+            return status;
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+Status print_formatted_to_buffer(OutputBuffer* buffer, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    Status status = output_buffer_vprintf(buffer, format, args);
+    va_end(args);
+    return status;
+}
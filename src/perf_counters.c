@@ -0,0 +1,205 @@
+#include "utils_internal.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define UTILS_HAVE_PERF_EVENTS
+#endif
+
+// ============================================================================
+// 硬件性能计数器
+//
+// 第一个成功打开的事件作为组长，其余事件加入同一组，保证它们在同一时间段
+// 内计数，一次read读出全部值。打开失败的事件（虚拟机里常见的缓存事件、
+// perf_event_paranoid限制等）直接跳过。
+// ============================================================================
+
+struct PerfCounters {
+    int fds[PERF_COUNTER_COUNT];
+    uint64_t ids[PERF_COUNTER_COUNT];
+    int leader;                       // 组长的fd，-1表示没有任何可用计数器
+    uint32_t available;
+};
+
+static const char* const perf_counter_names[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"
+};
+
+const char* perf_counter_name(PerfCounterKind kind) {
+    return ((unsigned)kind < PERF_COUNTER_COUNT) ? perf_counter_names[kind] : "unknown";
+}
+
+#ifdef UTILS_HAVE_PERF_EVENTS
+static void perf_event_config(PerfCounterKind kind, struct perf_event_attr* attr) {
+    switch (kind) {
+        case PERF_COUNTER_CYCLES:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PERF_COUNTER_INSTRUCTIONS:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PERF_COUNTER_BRANCH_MISSES:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PERF_COUNTER_L1D_MISSES:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_L1D |
+                           ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        default:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+    }
+}
+
+static int perf_event_open_counter(PerfCounterKind kind, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    perf_event_config(kind, &attr);
+    attr.disabled = (group_fd == -1);     // 组长控制整组的启停
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // 只统计调用线程，在任意CPU上
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+PerfCounters* perf_counters_create(void) {
+    PerfCounters* counters = (PerfCounters*)calloc(1, sizeof(PerfCounters));
+    if (!counters) {
+        return NULL;
+    }
+
+    counters->leader = -1;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters->fds[i] = -1;
+    }
+
+#ifdef UTILS_HAVE_PERF_EVENTS
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        int fd = perf_event_open_counter((PerfCounterKind)i, counters->leader);
+        if (fd < 0) {
+            continue;
+        }
+        if (ioctl(fd, PERF_EVENT_IOC_ID, &counters->ids[i]) != 0) {
+            close(fd);
+            continue;
+        }
+
+        counters->fds[i] = fd;
+        counters->available |= PERF_COUNTER_BIT(i);
+        if (counters->leader == -1) {
+            counters->leader = fd;
+        }
+    }
+#endif
+
+    return counters;
+}
+
+void perf_counters_destroy(PerfCounters* counters) {
+    if (!counters) {
+        return;
+    }
+
+#ifdef UTILS_HAVE_PERF_EVENTS
+    // 先关闭组员，最后关闭组长
+    for (int i = PERF_COUNTER_COUNT - 1; i >= 0; i--) {
+        if (counters->fds[i] >= 0 && counters->fds[i] != counters->leader) {
+            close(counters->fds[i]);
+        }
+    }
+    if (counters->leader >= 0) {
+        close(counters->leader);
+    }
+#endif
+
+    free(counters);
+}
+
+uint32_t perf_counters_available(const PerfCounters* counters) {
+    return counters ? counters->available : 0;
+}
+
+Status perf_counters_start(PerfCounters* counters) {
+    if (!counters) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (counters->leader < 0) {
+        return STATUS_ERROR;
+    }
+
+#ifdef UTILS_HAVE_PERF_EVENTS
+    if (ioctl(counters->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) != 0 ||
+        ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0) {
+        return STATUS_ERROR;
+    }
+    return STATUS_SUCCESS;
+#else
+    return STATUS_ERROR;
+#endif
+}
+
+Status perf_counters_stop(PerfCounters* counters, PerfCounterValues* values) {
+    if (!counters || !values) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    memset(values, 0, sizeof(*values));
+    if (counters->leader < 0) {
+        return STATUS_ERROR;
+    }
+
+#ifdef UTILS_HAVE_PERF_EVENTS
+    if (ioctl(counters->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) != 0) {
+        return STATUS_ERROR;
+    }
+
+    // PERF_FORMAT_GROUP布局: nr, time_enabled, time_running, {value, id} * nr
+    uint64_t buffer[3 + 2 * PERF_COUNTER_COUNT];
+    ssize_t bytes = read(counters->leader, buffer, sizeof(buffer));
+    if (bytes < (ssize_t)(3 * sizeof(uint64_t))) {
+        return STATUS_ERROR;
+    }
+
+    uint64_t count = MIN(buffer[0], (uint64_t)PERF_COUNTER_COUNT);
+    uint64_t time_enabled = buffer[1];
+    uint64_t time_running = buffer[2];
+    if (time_running == 0) {
+        // 整组从未被调度上PMU（例如组内事件过多），没有有效数值
+        return STATUS_ERROR;
+    }
+
+    double scale = 1.0;
+    if (time_running < time_enabled) {
+        scale = (double)time_enabled / (double)time_running;
+        values->multiplexed = true;
+    }
+
+    for (uint64_t n = 0; n < count; n++) {
+        uint64_t value = buffer[3 + 2 * n];
+        uint64_t id = buffer[3 + 2 * n + 1];
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            if (counters->fds[i] >= 0 && counters->ids[i] == id) {
+                values->values[i] = (uint64_t)((double)value * scale);
+                values->available |= PERF_COUNTER_BIT(i);
+                break;
+            }
+        }
+    }
+    return STATUS_SUCCESS;
+#else
+    return STATUS_ERROR;
+#endif
+}
@@ -0,0 +1,278 @@
+#include "utils_internal.h"
+
+// ============================================================================
+// 多级流水线
+//
+// 阶段i从queues[i]取缓冲区，处理后放入queues[i+1]；pipeline_submit写入
+// queues[0]。每个队列只有一个生产者和一个消费者，用两个单调递增的下标
+// 加发布/获取语义即可同步，不需要锁。等待时先自旋，再让出CPU，长时间
+// 空闲才睡眠，避免在单核机器上空转。
+// ============================================================================
+
+#define PIPELINE_SPIN_COUNT 64
+#define PIPELINE_YIELD_COUNT 1024
+
+typedef struct {
+    void* data;
+    size_t size;
+    bool end;                     // 结束标记，沿流水线逐级传递
+    bool failed;                  // 某一阶段已返回错误，后续阶段跳过处理
+} PipelineItem;
+
+typedef struct {
+    volatile int64_t tail;        // 生产者写入位置
+    char tail_padding[UTILS_CACHE_LINE_SIZE - sizeof(int64_t)];
+    volatile int64_t head;        // 消费者读取位置
+    char head_padding[UTILS_CACHE_LINE_SIZE - sizeof(int64_t)];
+    PipelineItem* items;
+    size_t capacity;
+    size_t mask;
+} PipelineQueue;
+
+typedef struct {
+    Pipeline* pipeline;
+    size_t index;
+} PipelineStageArg;
+
+struct Pipeline {
+    ProcessFunc stages[PIPELINE_MAX_STAGES];
+    PipelineStageStats stats[PIPELINE_MAX_STAGES];
+    Status status[PIPELINE_MAX_STAGES];
+    PipelineQueue queues[PIPELINE_MAX_STAGES];
+    PipelineStageArg args[PIPELINE_MAX_STAGES];
+    UtilsThread threads[PIPELINE_MAX_STAGES];
+    size_t stage_count;
+    size_t thread_count;
+    size_t queue_capacity;
+    PipelineReleaseFunc release;
+    void* release_ctx;
+    double submit_wait_seconds;
+    bool started;
+    bool finished;
+};
+
+// 等待条件成立前的退避：第round次等待时调用
+static void pipeline_backoff(size_t round) {
+    if (round < PIPELINE_SPIN_COUNT) {
+        utils_cpu_relax();
+    } else if (round < PIPELINE_SPIN_COUNT + PIPELINE_YIELD_COUNT) {
+        utils_thread_yield();
+    } else {
+        utils_sleep_ms(1);
+    }
+}
+
+static Status pipeline_queue_init(PipelineQueue* queue, size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    queue->items = (PipelineItem*)malloc(rounded * sizeof(PipelineItem));
+    if (!queue->items) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    queue->tail = 0;
+    queue->head = 0;
+    queue->capacity = rounded;
+    queue->mask = rounded - 1;
+    return STATUS_SUCCESS;
+}
+
+// 队列满时阻塞（背压），等待时间累加到wait_seconds
+static void pipeline_queue_push(PipelineQueue* queue, PipelineItem item, double* wait_seconds) {
+    int64_t tail = queue->tail;
+
+    if (tail - utils_atomic_load_acquire64(&queue->head) >= (int64_t)queue->capacity) {
+        double start = utils_now_seconds();
+        size_t round = 0;
+        while (tail - utils_atomic_load_acquire64(&queue->head) >= (int64_t)queue->capacity) {
+            pipeline_backoff(round++);
+        }
+        *wait_seconds += utils_now_seconds() - start;
+    }
+
+    queue->items[(size_t)tail & queue->mask] = item;
+    utils_atomic_store_release64(&queue->tail, tail + 1);
+}
+
+static PipelineItem pipeline_queue_pop(PipelineQueue* queue, double* wait_seconds) {
+    int64_t head = queue->head;
+
+    if (utils_atomic_load_acquire64(&queue->tail) == head) {
+        double start = utils_now_seconds();
+        size_t round = 0;
+        while (utils_atomic_load_acquire64(&queue->tail) == head) {
+            pipeline_backoff(round++);
+        }
+        *wait_seconds += utils_now_seconds() - start;
+    }
+
+    PipelineItem item = queue->items[(size_t)head & queue->mask];
+    utils_atomic_store_release64(&queue->head, head + 1);
+    return item;
+}
+
+static void pipeline_release(Pipeline* pipeline, PipelineItem item) {
+    if (pipeline->release) {
+        pipeline->release(item.data, item.size, pipeline->release_ctx);
+    }
+}
+
+static UTILS_THREAD_RETURN pipeline_stage_thread(void* arg) {
+    PipelineStageArg* stage_arg = (PipelineStageArg*)arg;
+    Pipeline* pipeline = stage_arg->pipeline;
+    size_t index = stage_arg->index;
+    bool is_last = (index + 1 == pipeline->stage_count);
+    ProcessFunc stage = pipeline->stages[index];
+    PipelineStageStats* stats = &pipeline->stats[index];
+
+    for (;;) {
+        PipelineItem item = pipeline_queue_pop(&pipeline->queues[index], &stats->wait_seconds);
+        if (item.end) {
+            if (!is_last) {
+                pipeline_queue_push(&pipeline->queues[index + 1], item, &stats->wait_seconds);
+            }
+            break;
+        }
+
+        // 出错的缓冲区仍然传到最后一个阶段再回收，保证release只在一个线程上调用
+        if (!item.failed) {
+            double start = utils_now_seconds();
+            Status status = stage(item.data, item.size);
+            stats->busy_seconds += utils_now_seconds() - start;
+            stats->items++;
+            stats->bytes += item.size;
+
+            if (status != STATUS_SUCCESS) {
+                item.failed = true;
+                if (pipeline->status[index] == STATUS_SUCCESS) {
+                    pipeline->status[index] = status;
+                }
+            }
+        }
+
+        if (is_last) {
+            pipeline_release(pipeline, item);
+        } else {
+            pipeline_queue_push(&pipeline->queues[index + 1], item, &stats->wait_seconds);
+        }
+    }
+
+    return 0;
+}
+
+Pipeline* pipeline_create(size_t queue_capacity, PipelineReleaseFunc release, void* release_ctx) {
+    Pipeline* pipeline = (Pipeline*)calloc(1, sizeof(Pipeline));
+    if (!pipeline) {
+        return NULL;
+    }
+
+    pipeline->queue_capacity = (queue_capacity > 0) ? queue_capacity : PIPELINE_DEFAULT_QUEUE_CAPACITY;
+    pipeline->release = release;
+    pipeline->release_ctx = release_ctx;
+    return pipeline;
+}
+
+Status pipeline_add_stage(Pipeline* pipeline, ProcessFunc stage) {
+    if (!pipeline || !stage || pipeline->started) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (pipeline->stage_count == PIPELINE_MAX_STAGES) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    pipeline->stages[pipeline->stage_count] = stage;
+    pipeline->status[pipeline->stage_count] = STATUS_SUCCESS;
+    pipeline->stage_count++;
+    return STATUS_SUCCESS;
+}
+
+Status pipeline_start(Pipeline* pipeline) {
+    if (!pipeline || pipeline->started || pipeline->stage_count == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    for (size_t i = 0; i < pipeline->stage_count; i++) {
+        Status status = pipeline_queue_init(&pipeline->queues[i], pipeline->queue_capacity);
+        if (status != STATUS_SUCCESS) {
+            return status;
+        }
+    }
+
+    pipeline->started = true;
+    for (size_t i = 0; i < pipeline->stage_count; i++) {
+        pipeline->args[i].pipeline = pipeline;
+        pipeline->args[i].index = i;
+        if (!utils_thread_create(&pipeline->threads[i], pipeline_stage_thread, &pipeline->args[i])) {
+            // 已启动的阶段收到结束标记后退出，标记停留在未启动阶段的输入队列中
+            pipeline_finish(pipeline);
+            return STATUS_ERROR;
+        }
+        pipeline->thread_count++;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+Status pipeline_submit(Pipeline* pipeline, void* data, size_t size) {
+    if (!pipeline || !pipeline->started || pipeline->finished) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    PipelineItem item = { data, size, false, false };
+    pipeline_queue_push(&pipeline->queues[0], item, &pipeline->submit_wait_seconds);
+    return STATUS_SUCCESS;
+}
+
+Status pipeline_finish(Pipeline* pipeline) {
+    if (!pipeline || !pipeline->started) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    if (!pipeline->finished) {
+        pipeline->finished = true;
+        if (pipeline->thread_count > 0) {
+            PipelineItem end = { NULL, 0, true, false };
+            pipeline_queue_push(&pipeline->queues[0], end, &pipeline->submit_wait_seconds);
+        }
+        for (size_t i = 0; i < pipeline->thread_count; i++) {
+            utils_thread_join(pipeline->threads[i]);
+        }
+    }
+
+    for (size_t i = 0; i < pipeline->stage_count; i++) {
+        if (pipeline->status[i] != STATUS_SUCCESS) {
+            return pipeline->status[i];
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+Status pipeline_get_stage_stats(const Pipeline* pipeline, size_t stage, PipelineStageStats* stats) {
+    if (!pipeline || !stats || stage >= pipeline->stage_count) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    *stats = pipeline->stats[stage];
+    return STATUS_SUCCESS;
+}
+
+double pipeline_submit_wait_seconds(const Pipeline* pipeline) {
+    return pipeline ? pipeline->submit_wait_seconds : 0.0;
+}
+
+void pipeline_destroy(Pipeline* pipeline) {
+    if (!pipeline) {
+        return;
+    }
+
+    if (pipeline->started) {
+        pipeline_finish(pipeline);
+    }
+    for (size_t i = 0; i < PIPELINE_MAX_STAGES; i++) {
+        free(pipeline->queues[i].items);
+    }
+    free(pipeline);
+}
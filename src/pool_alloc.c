@@ -0,0 +1,611 @@
+#include "utils_internal.h"
+
+#include <assert.h>
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif
+
+// ============================================================================
+// 按尺寸分级的线程缓存池分配器
+//
+// 分配路径：线程缓存 -> 中心空闲链表（加锁、批量补充） -> 新span（malloc）
+// 超过POOL_MAX_SMALL_SIZE的请求直接走malloc；超过POOL_MAPPED_THRESHOLD的
+// 清零请求使用新的匿名映射，页面在首次访问时才由内核清零并分配物理内存。
+// 每个块前有16字节块头，记录尺寸级别和请求大小，因此释放时不需要调用方提供大小。
+// 块头的magic只在块被分配出去期间有效，挂在空闲链表上的块magic为0，
+// 因此重复释放或释放非本分配器的指针会在块头检查时立即终止进程。
+//
+// 统计计数同样按线程记录在线程缓存中，快速路径上只写本线程的计数器。
+// 存活字节的增量在访问中心链表、大块分配和线程退出时并入全局值，峰值也只在
+// 这些时刻更新，因此峰值的误差不超过各线程缓存中块的总字节数。
+// ============================================================================
+
+#define POOL_MAX_SMALL_SIZE 32768
+#define POOL_LARGE_CLASS 0xFFFFFFFFu
+#define POOL_MAPPED_CLASS 0xFFFFFFFEu
+#define POOL_MAPPED_THRESHOLD (256 * 1024)
+#define POOL_MAPPED_PREFIX 16             // 映射起始处保存映射长度
+#define POOL_MAGIC 0x504F4F4Cu        // "POOL"
+#define POOL_SPAN_SIZE (64 * 1024)
+
+typedef struct {
+    uint32_t size_class;
+    uint32_t magic;
+    uint64_t size;                    // 调用方请求的字节数
+} PoolHeader;
+
+static const uint32_t pool_class_sizes[POOL_SIZE_CLASS_COUNT] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256, 320, 384, 448, 512,
+    640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+    2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192,
+    10240, 12288, 14336, 16384, 20480, 24576, 28672, 32768
+};
+
+typedef struct {
+    UtilsMutex lock;
+    PoolHeader* head;
+    size_t count;
+    char padding[UTILS_CACHE_LINE_SIZE];
+} PoolCentralList;
+
+typedef struct {
+    PoolHeader* head;
+    uint32_t count;
+} PoolFreeList;
+
+// 只由所属线程写入，pool_get_stats从其他线程读取
+typedef struct {
+    volatile int64_t live_bytes;      // 尚未并入pool_stat_live_bytes的净分配字节数，可为负
+    volatile int64_t allocs;
+    volatile int64_t frees;
+    volatile int64_t large_allocs;
+    volatile int64_t mapped_allocs;
+    volatile int64_t reallocs;
+    volatile int64_t reallocs_in_place;
+    volatile int64_t class_allocs[POOL_SIZE_CLASS_COUNT];
+} PoolThreadStats;
+
+typedef struct PoolThreadCache {
+    PoolFreeList lists[POOL_SIZE_CLASS_COUNT];
+    PoolThreadStats stats;
+    struct PoolThreadCache* prev;     // 已注册线程链表，持pool_registry_lock访问
+    struct PoolThreadCache* next;
+    bool registered;
+} PoolThreadCache;
+
+static PoolCentralList pool_central[POOL_SIZE_CLASS_COUNT];
+static UtilsOnce pool_init_once = UTILS_ONCE_INIT;
+static UTILS_THREAD_LOCAL PoolThreadCache pool_tls_cache;
+
+// 已注册线程和已退出线程的累计计数
+static UtilsMutex pool_registry_lock;
+static PoolThreadCache* pool_registry_head;
+static PoolThreadStats pool_retired_stats;
+
+// 已并入的存活字节数和峰值
+static volatile int64_t pool_stat_live_bytes;
+static volatile int64_t pool_stat_peak_bytes;
+
+static void pool_thread_retire(PoolThreadCache* cache);
+
+#ifdef PLATFORM_WINDOWS
+static DWORD pool_fls_index = FLS_OUT_OF_INDEXES;
+
+static void WINAPI pool_thread_exit_callback(PVOID data) {
+    if (data) {
+        pool_thread_cache_flush();
+        pool_thread_retire((PoolThreadCache*)data);
+    }
+}
+#else
+static pthread_key_t pool_thread_key;
+
+static void pool_thread_exit_callback(void* data) {
+    if (data) {
+        pool_thread_cache_flush();
+        pool_thread_retire((PoolThreadCache*)data);
+    }
+}
+#endif
+
+static void pool_init(void) {
+    utils_mutex_init(&pool_registry_lock);
+    for (size_t i = 0; i < POOL_SIZE_CLASS_COUNT; i++) {
+        utils_mutex_init(&pool_central[i].lock);
+        pool_central[i].head = NULL;
+        pool_central[i].count = 0;
+    }
+
+    // 线程退出时把线程缓存归还到中心链表
+#ifdef PLATFORM_WINDOWS
+    pool_fls_index = FlsAlloc(pool_thread_exit_callback);
+#else
+    pthread_key_create(&pool_thread_key, pool_thread_exit_callback);
+#endif
+}
+
+static void pool_register_thread(void) {
+    PoolThreadCache* cache = &pool_tls_cache;
+    cache->registered = true;
+
+    utils_mutex_lock(&pool_registry_lock);
+    cache->prev = NULL;
+    cache->next = pool_registry_head;
+    if (pool_registry_head) {
+        pool_registry_head->prev = cache;
+    }
+    pool_registry_head = cache;
+    utils_mutex_unlock(&pool_registry_lock);
+
+#ifdef PLATFORM_WINDOWS
+    if (pool_fls_index != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(pool_fls_index, cache);
+    }
+#else
+    pthread_setspecific(pool_thread_key, cache);
+#endif
+}
+
+static PoolThreadCache* pool_thread_cache(void) {
+    if (!pool_tls_cache.registered) {
+        pool_register_thread();
+    }
+    return &pool_tls_cache;
+}
+
+// 线程私有计数器只有所属线程写入，普通的读-改-写即可，不需要加锁的原子指令
+static inline void pool_stat_add(volatile int64_t* counter, int64_t delta) {
+    *counter += delta;
+}
+
+// 把本线程的存活字节增量并入全局值并更新峰值，只在慢路径上调用
+static void pool_publish_live_bytes(PoolThreadCache* cache) {
+    int64_t delta = cache->stats.live_bytes;
+    if (delta == 0) {
+        return;
+    }
+    cache->stats.live_bytes = 0;
+    int64_t live = utils_atomic_add64(&pool_stat_live_bytes, delta);
+    utils_atomic_max64(&pool_stat_peak_bytes, live);
+}
+
+static void pool_stats_accumulate(PoolThreadStats* total, PoolThreadStats* stats) {
+    total->live_bytes += utils_atomic_load64(&stats->live_bytes);
+    total->allocs += utils_atomic_load64(&stats->allocs);
+    total->frees += utils_atomic_load64(&stats->frees);
+    total->large_allocs += utils_atomic_load64(&stats->large_allocs);
+    total->mapped_allocs += utils_atomic_load64(&stats->mapped_allocs);
+    total->reallocs += utils_atomic_load64(&stats->reallocs);
+    total->reallocs_in_place += utils_atomic_load64(&stats->reallocs_in_place);
+    for (size_t i = 0; i < POOL_SIZE_CLASS_COUNT; i++) {
+        total->class_allocs[i] += utils_atomic_load64(&stats->class_allocs[i]);
+    }
+}
+
+// 线程退出时把计数并入pool_retired_stats并从注册链表中摘除
+static void pool_thread_retire(PoolThreadCache* cache) {
+    pool_publish_live_bytes(cache);
+
+    utils_mutex_lock(&pool_registry_lock);
+    pool_stats_accumulate(&pool_retired_stats, &cache->stats);
+    if (cache->prev) {
+        cache->prev->next = cache->next;
+    } else {
+        pool_registry_head = cache->next;
+    }
+    if (cache->next) {
+        cache->next->prev = cache->prev;
+    }
+    utils_mutex_unlock(&pool_registry_lock);
+
+    memset((void*)&cache->stats, 0, sizeof(cache->stats));
+    cache->prev = NULL;
+    cache->next = NULL;
+    cache->registered = false;
+}
+
+static uint32_t pool_size_to_class(size_t size) {
+    uint32_t low = 0;
+    uint32_t high = POOL_SIZE_CLASS_COUNT - 1;
+
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (pool_class_sizes[mid] < size) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static uint32_t pool_batch_size(uint32_t size_class) {
+    uint32_t batch = 8192 / pool_class_sizes[size_class];
+    return MAX(4u, MIN(64u, batch));
+}
+
+static void* pool_next(PoolHeader* block) {
+    return *(void**)(block + 1);
+}
+
+static void pool_set_next(PoolHeader* block, void* next) {
+    *(void**)(block + 1) = next;
+}
+
+// 从中心链表取出最多batch个块，不足时切分新span
+static uint32_t pool_central_fetch(uint32_t size_class, uint32_t batch, PoolHeader** out_head) {
+    PoolCentralList* central = &pool_central[size_class];
+    PoolHeader* head = NULL;
+    uint32_t fetched = 0;
+
+    utils_mutex_lock(&central->lock);
+
+    while (fetched < batch && central->head) {
+        PoolHeader* block = central->head;
+        central->head = (PoolHeader*)pool_next(block);
+        central->count--;
+        pool_set_next(block, head);
+        head = block;
+        fetched++;
+    }
+
+    if (fetched < batch) {
+        size_t block_size = sizeof(PoolHeader) + pool_class_sizes[size_class];
+        size_t span_blocks = MAX((size_t)batch, POOL_SPAN_SIZE / block_size);
+        char* span = (char*)malloc(span_blocks * block_size);
+
+        if (span) {
+            for (size_t i = 0; i < span_blocks; i++) {
+                PoolHeader* block = (PoolHeader*)(span + i * block_size);
+                block->size_class = size_class;
+                block->magic = 0;
+                if (fetched < batch) {
+                    pool_set_next(block, head);
+                    head = block;
+                    fetched++;
+                } else {
+                    pool_set_next(block, central->head);
+                    central->head = block;
+                    central->count++;
+                }
+            }
+        }
+    }
+
+    utils_mutex_unlock(&central->lock);
+
+    *out_head = head;
+    return fetched;
+}
+
+static void pool_central_release(uint32_t size_class, PoolFreeList* list, uint32_t count) {
+    PoolCentralList* central = &pool_central[size_class];
+
+    utils_mutex_lock(&central->lock);
+    while (count > 0 && list->head) {
+        PoolHeader* block = list->head;
+        list->head = (PoolHeader*)pool_next(block);
+        list->count--;
+        pool_set_next(block, central->head);
+        central->head = block;
+        central->count++;
+        count--;
+    }
+    utils_mutex_unlock(&central->lock);
+}
+
+// 块头损坏、重复释放或指针不属于本分配器时继续执行只会破坏空闲链表，直接终止
+static void pool_check_header(const PoolHeader* block, const char* caller) {
+    if (block->magic != POOL_MAGIC) {
+        assert(!"pool: invalid block header (double free or foreign pointer)");
+        fprintf(stderr, "%s: invalid block header at %p (double free or foreign pointer)\n",
+                caller, (const void*)block);
+        abort();
+    }
+}
+
+// 新的匿名映射天然是零页，不需要memset
+static PoolHeader* pool_map_zeroed(size_t size) {
+    if (size > SIZE_MAX - POOL_MAPPED_PREFIX - sizeof(PoolHeader)) {
+        return NULL;
+    }
+    size_t total = POOL_MAPPED_PREFIX + sizeof(PoolHeader) + size;
+
+#ifdef PLATFORM_WINDOWS
+    void* base = VirtualAlloc(NULL, total, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!base) {
+        return NULL;
+    }
+#else
+    void* base = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+#endif
+
+    *(size_t*)base = total;
+    PoolHeader* block = (PoolHeader*)((char*)base + POOL_MAPPED_PREFIX);
+    block->size_class = POOL_MAPPED_CLASS;
+    block->magic = POOL_MAGIC;
+    return block;
+}
+
+static size_t pool_mapped_capacity(PoolHeader* block) {
+    size_t total = *(size_t*)((char*)block - POOL_MAPPED_PREFIX);
+    return total - POOL_MAPPED_PREFIX - sizeof(PoolHeader);
+}
+
+static void pool_unmap(PoolHeader* block) {
+    char* base = (char*)block - POOL_MAPPED_PREFIX;
+#ifdef PLATFORM_WINDOWS
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, *(size_t*)base);
+#endif
+}
+
+// ============================================================================
+// 公开接口
+// ============================================================================
+
+void* pool_malloc(size_t size) {
+    if (size == 0) {
+        return NULL;
+    }
+
+    utils_call_once(&pool_init_once, pool_init);
+
+    PoolThreadCache* cache = pool_thread_cache();
+    PoolHeader* block;
+    if (size > POOL_MAX_SMALL_SIZE) {
+        if (size > SIZE_MAX - sizeof(PoolHeader)) {
+            return NULL;
+        }
+        block = (PoolHeader*)malloc(sizeof(PoolHeader) + size);
+        if (!block) {
+            return NULL;
+        }
+        block->size_class = POOL_LARGE_CLASS;
+        block->magic = POOL_MAGIC;
+        block->size = size;
+        pool_stat_add(&cache->stats.large_allocs, 1);
+        pool_stat_add(&cache->stats.allocs, 1);
+        pool_stat_add(&cache->stats.live_bytes, (int64_t)size);
+        pool_publish_live_bytes(cache);
+        return block + 1;
+    }
+
+    uint32_t size_class = pool_size_to_class(size);
+    PoolFreeList* list = &cache->lists[size_class];
+
+    if (!list->head) {
+        // 访问中心链表时顺便并入存活字节，峰值在这里更新
+        pool_publish_live_bytes(cache);
+        list->count = pool_central_fetch(size_class, pool_batch_size(size_class), &list->head);
+        if (!list->head) {
+            return NULL;
+        }
+    }
+
+    block = list->head;
+    list->head = (PoolHeader*)pool_next(block);
+    list->count--;
+    block->magic = POOL_MAGIC;
+    block->size = size;
+    pool_stat_add(&cache->stats.class_allocs[size_class], 1);
+    pool_stat_add(&cache->stats.allocs, 1);
+    pool_stat_add(&cache->stats.live_bytes, (int64_t)size);
+
+    return block + 1;
+}
+
+void pool_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    PoolHeader* block = (PoolHeader*)ptr - 1;
+    pool_check_header(block, "pool_free");
+
+    PoolThreadCache* cache = pool_thread_cache();
+    pool_stat_add(&cache->stats.frees, 1);
+    pool_stat_add(&cache->stats.live_bytes, -(int64_t)block->size);
+
+    if (block->size_class == POOL_LARGE_CLASS) {
+        block->magic = 0;
+        free(block);
+        pool_publish_live_bytes(cache);
+        return;
+    }
+    if (block->size_class == POOL_MAPPED_CLASS) {
+        block->magic = 0;
+        pool_unmap(block);
+        pool_publish_live_bytes(cache);
+        return;
+    }
+
+    uint32_t size_class = block->size_class;
+    PoolFreeList* list = &cache->lists[size_class];
+    uint32_t batch = pool_batch_size(size_class);
+
+    block->magic = 0;
+    pool_set_next(block, list->head);
+    list->head = block;
+    list->count++;
+
+    // 线程缓存过大时批量归还一半，避免生产者/消费者线程间单向堆积
+    if (list->count > 2 * batch) {
+        pool_central_release(size_class, list, batch);
+        pool_publish_live_bytes(cache);
+    }
+}
+
+void* pool_realloc(void* ptr, size_t new_size) {
+    if (!ptr) {
+        return pool_malloc(new_size);
+    }
+    if (new_size == 0) {
+        pool_free(ptr);
+        return NULL;
+    }
+
+    PoolHeader* block = (PoolHeader*)ptr - 1;
+    pool_check_header(block, "pool_realloc");
+
+    PoolThreadCache* cache = pool_thread_cache();
+    pool_stat_add(&cache->stats.reallocs, 1);
+    int64_t old_size = (int64_t)block->size;
+
+    // 小对象在当前尺寸级别容量内、映射块在映射长度内可以原地调整
+    size_t capacity = 0;
+    if (block->size_class < POOL_SIZE_CLASS_COUNT) {
+        capacity = pool_class_sizes[block->size_class];
+    } else if (block->size_class == POOL_MAPPED_CLASS) {
+        capacity = pool_mapped_capacity(block);
+    }
+
+    if (new_size <= capacity) {
+        block->size = new_size;
+        pool_stat_add(&cache->stats.reallocs_in_place, 1);
+        pool_stat_add(&cache->stats.live_bytes, (int64_t)new_size - old_size);
+        return ptr;
+    }
+
+    if (block->size_class == POOL_LARGE_CLASS && new_size > POOL_MAX_SMALL_SIZE) {
+        if (new_size > SIZE_MAX - sizeof(PoolHeader)) {
+            return NULL;
+        }
+        PoolHeader* resized = (PoolHeader*)realloc(block, sizeof(PoolHeader) + new_size);
+        if (!resized) {
+            return NULL;
+        }
+        if (resized == block) {
+            pool_stat_add(&cache->stats.reallocs_in_place, 1);
+        }
+        resized->size = new_size;
+        pool_stat_add(&cache->stats.live_bytes, (int64_t)new_size - old_size);
+        pool_publish_live_bytes(cache);
+        return resized + 1;
+    }
+
+    void* new_ptr = pool_malloc(new_size);
+    if (!new_ptr) {
+        return NULL;
+    }
+    memcpy(new_ptr, ptr, MIN((size_t)old_size, new_size));
+    pool_free(ptr);
+
+    return new_ptr;
+}
+
+void* pool_calloc(size_t count, size_t size) {
+    if (count == 0 || size == 0 || count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    size_t total = count * size;
+    if (total < POOL_MAPPED_THRESHOLD) {
+        void* ptr = pool_malloc(total);
+        if (ptr) {
+            memset(ptr, 0, total);
+        }
+        return ptr;
+    }
+
+    utils_call_once(&pool_init_once, pool_init);
+
+    PoolHeader* block = pool_map_zeroed(total);
+    if (!block) {
+        return NULL;
+    }
+
+    PoolThreadCache* cache = pool_thread_cache();
+    block->size = total;
+    pool_stat_add(&cache->stats.allocs, 1);
+    pool_stat_add(&cache->stats.mapped_allocs, 1);
+    pool_stat_add(&cache->stats.live_bytes, (int64_t)total);
+    pool_publish_live_bytes(cache);
+
+    return block + 1;
+}
+
+void pool_thread_cache_flush(void) {
+    for (uint32_t i = 0; i < POOL_SIZE_CLASS_COUNT; i++) {
+        PoolFreeList* list = &pool_tls_cache.lists[i];
+        if (list->head) {
+            pool_central_release(i, list, list->count);
+        }
+    }
+}
+
+size_t pool_size_class_bytes(size_t size_class) {
+    return (size_class < POOL_SIZE_CLASS_COUNT) ? pool_class_sizes[size_class] : 0;
+}
+
+Status pool_get_stats(PoolAllocatorStats* stats) {
+    if (!stats) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    utils_call_once(&pool_init_once, pool_init);
+
+    // 汇总已退出线程和所有已注册线程的计数；其他线程仍在运行时结果是近似快照
+    PoolThreadStats total;
+    memset(&total, 0, sizeof(total));
+    utils_mutex_lock(&pool_registry_lock);
+    pool_stats_accumulate(&total, &pool_retired_stats);
+    for (PoolThreadCache* cache = pool_registry_head; cache; cache = cache->next) {
+        pool_stats_accumulate(&total, &cache->stats);
+    }
+    utils_mutex_unlock(&pool_registry_lock);
+
+    int64_t live = utils_atomic_load64(&pool_stat_live_bytes) + total.live_bytes;
+    utils_atomic_max64(&pool_stat_peak_bytes, live);
+
+    stats->live_bytes = live;
+    stats->peak_bytes = utils_atomic_load64(&pool_stat_peak_bytes);
+    stats->total_allocations = total.allocs;
+    stats->total_frees = total.frees;
+    stats->large_allocations = total.large_allocs;
+    stats->mapped_allocations = total.mapped_allocs;
+    stats->realloc_count = total.reallocs;
+    stats->realloc_in_place = total.reallocs_in_place;
+    for (size_t i = 0; i < POOL_SIZE_CLASS_COUNT; i++) {
+        stats->class_allocations[i] = total.class_allocs[i];
+    }
+
+    return STATUS_SUCCESS;
+}
+
+Status pool_dump_stats(FILE* stream) {
+    if (!stream) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    PoolAllocatorStats stats;
+    pool_get_stats(&stats);
+
+    double in_place_rate = (stats.realloc_count > 0)
+        ? 100.0 * (double)stats.realloc_in_place / (double)stats.realloc_count
+        : 0.0;
+
+    fprintf(stream, "=== Pool Allocator Statistics ===\n");
+    fprintf(stream, "Live bytes: %lld, Peak bytes: %lld\n",
+            (long long)stats.live_bytes, (long long)stats.peak_bytes);
+    fprintf(stream, "Allocations: %lld, Frees: %lld, Large: %lld, Mapped: %lld\n",
+            (long long)stats.total_allocations, (long long)stats.total_frees,
+            (long long)stats.large_allocations, (long long)stats.mapped_allocations);
+    fprintf(stream, "Reallocs: %lld, In place: %lld (%.1f%%)\n",
+            (long long)stats.realloc_count, (long long)stats.realloc_in_place, in_place_rate);
+    fprintf(stream, "Size class allocations:\n");
+    for (size_t i = 0; i < POOL_SIZE_CLASS_COUNT; i++) {
+        if (stats.class_allocations[i] > 0) {
+            fprintf(stream, "  %6zu bytes: %lld\n",
+                    pool_size_class_bytes(i), (long long)stats.class_allocations[i]);
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,300 @@
+#include "utils_internal.h"
+
+// ============================================================================
+// 向量化数组扫描
+//
+// 每次处理16个int：比较结果（全1）和元素本身的符号位都落在每个32位通道的
+// 最高位，用movemask_ps一次取出，"等于目标"和"是负数"可以在同一趟扫描中
+// 用一次OR合并判断。
+//
+// 内核按指令集各编译一份（SSE2每次比较4个、AVX2每次8个、AVX-512每次16个），
+// 第一次调用时按cpu_features()选出当前CPU能用的最快一份，所以同一个库文件
+// 在老机器上走SSE2、在新机器上走AVX-512，不需要按机器分别编译。
+// ============================================================================
+
+#define SCAN_BLOCK 16
+
+typedef size_t (*ScanFirstFunc)(const int* array, size_t size, int target,
+                                bool match_equal, bool match_negative);
+typedef size_t (*ScanCountFunc)(const int* array, size_t size, int target);
+
+typedef struct {
+    const char* name;
+    ScanFirstFunc first;
+    ScanCountFunc count_equal;
+} ScanKernels;
+
+static inline bool scan_matches(int value, int target, bool match_equal, bool match_negative) {
+    return (match_negative && value < 0) || (match_equal && value == target);
+}
+
+// 从start开始逐个检查剩余元素
+static inline size_t scan_first_tail(const int* array, size_t start, size_t size, int target,
+                                     bool match_equal, bool match_negative) {
+    for (size_t i = start; i < size; i++) {
+        if (scan_matches(array[i], target, match_equal, match_negative)) {
+            return i;
+        }
+    }
+    return SCAN_NOT_FOUND;
+}
+
+static inline size_t scan_count_tail(const int* array, size_t start, size_t size, int target) {
+    size_t count = 0;
+    for (size_t i = start; i < size; i++) {
+        count += (array[i] == target);
+    }
+    return count;
+}
+
+// ============================================================================
+// 基线内核（x64上为SSE2，其他平台为标量）
+// ============================================================================
+
+#if defined(UTILS_HAVE_SSE2)
+static uint32_t popcount32(uint32_t value) {
+    value = value - ((value >> 1) & 0x55555555u);
+    value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+    value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+    return (value * 0x01010101u) >> 24;
+}
+
+// 返回16个元素的匹配位图，第i位对应p[i]
+static inline uint32_t scan_mask16_sse2(const int* p, __m128i target, bool match_equal, bool match_negative) {
+    uint32_t mask = 0;
+
+    for (int part = 0; part < 4; part++) {
+        __m128i values = _mm_loadu_si128((const __m128i*)(p + part * 4));
+        __m128i matches = _mm_setzero_si128();
+        if (match_equal) {
+            matches = _mm_cmpeq_epi32(values, target);
+        }
+        if (match_negative) {
+            matches = _mm_or_si128(matches, values);
+        }
+        mask |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(matches)) << (part * 4);
+    }
+
+    return mask;
+}
+
+static size_t scan_first_sse2(const int* array, size_t size, int target,
+                              bool match_equal, bool match_negative) {
+    __m128i target_vector = _mm_set1_epi32(target);
+    size_t i = 0;
+
+    for (; i + SCAN_BLOCK <= size; i += SCAN_BLOCK) {
+        uint32_t mask = scan_mask16_sse2(array + i, target_vector, match_equal, match_negative);
+        if (mask != 0) {
+            return i + utils_ctz32(mask);
+        }
+    }
+    return scan_first_tail(array, i, size, target, match_equal, match_negative);
+}
+
+static size_t scan_count_equal_sse2(const int* array, size_t size, int target) {
+    __m128i target_vector = _mm_set1_epi32(target);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + SCAN_BLOCK <= size; i += SCAN_BLOCK) {
+        count += popcount32(scan_mask16_sse2(array + i, target_vector, true, false));
+    }
+    return count + scan_count_tail(array, i, size, target);
+}
+
+static const ScanKernels scan_kernels_baseline = {
+    "sse2", scan_first_sse2, scan_count_equal_sse2
+};
+#else
+static size_t scan_first_scalar(const int* array, size_t size, int target,
+                                bool match_equal, bool match_negative) {
+    return scan_first_tail(array, 0, size, target, match_equal, match_negative);
+}
+
+static size_t scan_count_equal_scalar(const int* array, size_t size, int target) {
+    return scan_count_tail(array, 0, size, target);
+}
+
+static const ScanKernels scan_kernels_baseline = {
+    "scalar", scan_first_scalar, scan_count_equal_scalar
+};
+#endif
+
+#if defined(UTILS_ARCH_X86)
+// ============================================================================
+// AVX2内核
+// ============================================================================
+
+UTILS_TARGET_AVX2
+static inline uint32_t scan_mask16_avx2(const int* p, __m256i target, bool match_equal, bool match_negative) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)p);
+    __m256i b = _mm256_loadu_si256((const __m256i*)(p + 8));
+    __m256i mask_a = _mm256_setzero_si256();
+    __m256i mask_b = _mm256_setzero_si256();
+
+    if (match_equal) {
+        mask_a = _mm256_cmpeq_epi32(a, target);
+        mask_b = _mm256_cmpeq_epi32(b, target);
+    }
+    if (match_negative) {
+        mask_a = _mm256_or_si256(mask_a, a);
+        mask_b = _mm256_or_si256(mask_b, b);
+    }
+
+    return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(mask_a)) |
+           ((uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(mask_b)) << 8);
+}
+
+UTILS_TARGET_AVX2
+static size_t scan_first_avx2(const int* array, size_t size, int target,
+                              bool match_equal, bool match_negative) {
+    __m256i target_vector = _mm256_set1_epi32(target);
+    size_t i = 0;
+
+    for (; i + SCAN_BLOCK <= size; i += SCAN_BLOCK) {
+        uint32_t mask = scan_mask16_avx2(array + i, target_vector, match_equal, match_negative);
+        if (mask != 0) {
+            return i + utils_ctz32(mask);
+        }
+    }
+    return scan_first_tail(array, i, size, target, match_equal, match_negative);
+}
+
+UTILS_TARGET_AVX2
+static size_t scan_count_equal_avx2(const int* array, size_t size, int target) {
+    __m256i target_vector = _mm256_set1_epi32(target);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + SCAN_BLOCK <= size; i += SCAN_BLOCK) {
+        count += (size_t)_mm_popcnt_u32(scan_mask16_avx2(array + i, target_vector, true, false));
+    }
+    return count + scan_count_tail(array, i, size, target);
+}
+
+static const ScanKernels scan_kernels_avx2 = {
+    "avx2", scan_first_avx2, scan_count_equal_avx2
+};
+
+// ============================================================================
+// AVX-512内核
+//
+// 比较直接产生16位掩码寄存器，不需要movemask；不足16个的尾部用掩码加载，
+// 不会越界读取，也不需要标量收尾。
+// ============================================================================
+
+UTILS_TARGET_AVX512
+static inline uint32_t scan_mask16_avx512(const int* p, __mmask16 valid, __m512i target,
+                                          bool match_equal, bool match_negative) {
+    __m512i values = _mm512_maskz_loadu_epi32(valid, p);
+    __mmask16 mask = 0;
+
+    if (match_equal) {
+        mask = _mm512_mask_cmpeq_epi32_mask(valid, values, target);
+    }
+    if (match_negative) {
+        mask |= _mm512_mask_cmplt_epi32_mask(valid, values, _mm512_setzero_si512());
+    }
+    return mask;
+}
+
+UTILS_TARGET_AVX512
+static size_t scan_first_avx512(const int* array, size_t size, int target,
+                                bool match_equal, bool match_negative) {
+    __m512i target_vector = _mm512_set1_epi32(target);
+
+    for (size_t i = 0; i < size; i += SCAN_BLOCK) {
+        size_t remaining = size - i;
+        __mmask16 valid = (remaining >= SCAN_BLOCK) ? (__mmask16)0xFFFF
+                                                    : (__mmask16)((1u << remaining) - 1);
+        uint32_t mask = scan_mask16_avx512(array + i, valid, target_vector, match_equal, match_negative);
+        if (mask != 0) {
+            return i + utils_ctz32(mask);
+        }
+    }
+    return SCAN_NOT_FOUND;
+}
+
+UTILS_TARGET_AVX512
+static size_t scan_count_equal_avx512(const int* array, size_t size, int target) {
+    __m512i target_vector = _mm512_set1_epi32(target);
+    size_t count = 0;
+
+    for (size_t i = 0; i < size; i += SCAN_BLOCK) {
+        size_t remaining = size - i;
+        __mmask16 valid = (remaining >= SCAN_BLOCK) ? (__mmask16)0xFFFF
+                                                    : (__mmask16)((1u << remaining) - 1);
+        count += (size_t)_mm_popcnt_u32(scan_mask16_avx512(array + i, valid, target_vector, true, false));
+    }
+    return count;
+}
+
+static const ScanKernels scan_kernels_avx512 = {
+    "avx512", scan_first_avx512, scan_count_equal_avx512
+};
+#endif // UTILS_ARCH_X86
+
+// ============================================================================
+// 内核选择和公开接口
+// ============================================================================
+
+static const ScanKernels* scan_kernels = &scan_kernels_baseline;
+static UtilsOnce scan_select_once = UTILS_ONCE_INIT;
+
+static void scan_select_kernels(void) {
+#if defined(UTILS_ARCH_X86)
+    if (cpu_has_features(CPU_FEATURE_AVX512F | CPU_FEATURE_POPCNT)) {
+        scan_kernels = &scan_kernels_avx512;
+    } else if (cpu_has_features(CPU_FEATURE_AVX2 | CPU_FEATURE_POPCNT)) {
+        scan_kernels = &scan_kernels_avx2;
+    }
+#endif
+}
+
+static inline const ScanKernels* scan_get_kernels(void) {
+    utils_call_once(&scan_select_once, scan_select_kernels);
+    return scan_kernels;
+}
+
+static size_t scan_first(const int* array, size_t size, int target, bool match_equal, bool match_negative) {
+    return scan_get_kernels()->first(array, size, target, match_equal, match_negative);
+}
+
+size_t scan_find_equal(const int* array, size_t size, int target) {
+    if (!array) {
+        return SCAN_NOT_FOUND;
+    }
+    return scan_first(array, size, target, true, false);
+}
+
+size_t scan_find_negative(const int* array, size_t size) {
+    if (!array) {
+        return SCAN_NOT_FOUND;
+    }
+    return scan_first(array, size, 0, false, true);
+}
+
+size_t scan_find_equal_or_negative(const int* array, size_t size, int target, ScanReason* reason) {
+    size_t index = array ? scan_first(array, size, target, true, true) : SCAN_NOT_FOUND;
+
+    if (reason) {
+        if (index == SCAN_NOT_FOUND) {
+            *reason = SCAN_NONE;
+        } else {
+            *reason = (array[index] < 0) ? SCAN_NEGATIVE : SCAN_EQUAL;
+        }
+    }
+    return index;
+}
+
+size_t scan_count_equal(const int* array, size_t size, int target) {
+    if (!array) {
+        return 0;
+    }
+    return scan_get_kernels()->count_equal(array, size, target);
+}
+
+const char* scan_kernel_name(void) {
+    return scan_get_kernels()->name;
+}
@@ -0,0 +1,61 @@
+#include "utils_internal.h"
+
+// ============================================================================
+// 分片计数器
+//
+// 单个原子计数器在多核同时递增时所在缓存行会在核间来回迁移。这里每个线程
+// 第一次使用时按轮转分配一个分片，之后只修改该分片所在的缓存行，读取时再
+// 把所有分片相加。
+// ============================================================================
+
+static volatile int64_t next_shard = 0;
+static UTILS_THREAD_LOCAL int thread_shard = -1;
+
+static size_t current_shard(void) {
+    if (thread_shard < 0) {
+        int64_t ticket = utils_atomic_add64(&next_shard, 1) - 1;
+        thread_shard = (int)(ticket % SHARDED_COUNTER_SHARDS);
+    }
+    return (size_t)thread_shard;
+}
+
+void sharded_counter_init(ShardedCounter* counter, int64_t value) {
+    if (!counter) {
+        return;
+    }
+
+    for (size_t i = 0; i < SHARDED_COUNTER_SHARDS; i++) {
+        utils_atomic_store64(&counter->shards[i].value, 0);
+    }
+    utils_atomic_store64(&counter->shards[0].value, value);
+}
+
+void sharded_counter_add(ShardedCounter* counter, int64_t delta) {
+    if (!counter) {
+        return;
+    }
+
+    utils_atomic_add64(&counter->shards[current_shard()].value, delta);
+}
+
+int64_t sharded_counter_add_fetch(ShardedCounter* counter, int64_t delta) {
+    if (!counter) {
+        return 0;
+    }
+
+    return utils_atomic_add64(&counter->shards[current_shard()].value, delta);
+}
+
+int64_t sharded_counter_read(const ShardedCounter* counter) {
+    if (!counter) {
+        return 0;
+    }
+
+    // 原子操作接口不接受const指针，读取本身不修改计数器
+    ShardedCounter* shards = (ShardedCounter*)counter;
+    int64_t total = 0;
+    for (size_t i = 0; i < SHARDED_COUNTER_SHARDS; i++) {
+        total += utils_atomic_load64(&shards->shards[i].value);
+    }
+    return total;
+}
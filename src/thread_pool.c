@@ -0,0 +1,211 @@
+#include "utils_internal.h"
+
+#ifndef PLATFORM_WINDOWS
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// 线程池（fork-join式并行循环）
+//
+// 调用线程也参与执行，concurrency = 工作线程数 + 1。任务按grain切块，
+// 各线程通过原子计数器领取下一块，因此负载不均时也能自动平衡。
+// ============================================================================
+
+struct ThreadPool {
+    UtilsMutex lock;
+    UtilsMutex submit_lock;           // 串行化来自不同线程的parallel_for调用
+    UtilsCond work_cond;
+    UtilsCond done_cond;
+    UtilsThread* threads;
+    size_t num_workers;
+
+    // 当前任务（由lock保护发布）
+    ParallelForFunc func;
+    void* ctx;
+    size_t count;
+    size_t grain;
+    volatile int64_t next;
+    uint64_t generation;
+    size_t active;
+    bool shutdown;
+};
+
+typedef struct {
+    ThreadPool* pool;
+    size_t index;
+} ThreadPoolWorkerArg;
+
+static void thread_pool_run_chunks(ThreadPool* pool, ParallelForFunc func, void* ctx,
+                                   size_t count, size_t grain, size_t worker_index) {
+    for (;;) {
+        size_t begin = (size_t)(utils_atomic_add64(&pool->next, (int64_t)grain) - (int64_t)grain);
+        if (begin >= count) {
+            break;
+        }
+        size_t end = (count - begin > grain) ? begin + grain : count;
+        func(begin, end, worker_index, ctx);
+    }
+}
+
+static UTILS_THREAD_RETURN thread_pool_worker(void* arg) {
+    ThreadPoolWorkerArg* worker = (ThreadPoolWorkerArg*)arg;
+    ThreadPool* pool = worker->pool;
+    size_t index = worker->index;
+    uint64_t seen = 0;
+
+    free(worker);
+
+    utils_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            utils_cond_wait(&pool->work_cond, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+
+        seen = pool->generation;
+        ParallelForFunc func = pool->func;
+        void* ctx = pool->ctx;
+        size_t count = pool->count;
+        size_t grain = pool->grain;
+        utils_mutex_unlock(&pool->lock);
+
+        thread_pool_run_chunks(pool, func, ctx, count, grain, index);
+
+        utils_mutex_lock(&pool->lock);
+        if (--pool->active == 0) {
+            utils_cond_signal(&pool->done_cond);
+        }
+    }
+    utils_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+size_t utils_cpu_count(void) {
+#ifdef PLATFORM_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (size_t)count : 1;
+#endif
+}
+
+ThreadPool* thread_pool_create(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = utils_cpu_count();
+    }
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        return NULL;
+    }
+
+    utils_mutex_init(&pool->lock);
+    utils_mutex_init(&pool->submit_lock);
+    utils_cond_init(&pool->work_cond);
+    utils_cond_init(&pool->done_cond);
+
+    size_t workers = num_threads - 1;
+    if (workers > 0) {
+        pool->threads = (UtilsThread*)calloc(workers, sizeof(UtilsThread));
+        if (!pool->threads) {
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    for (size_t i = 0; i < workers; i++) {
+        ThreadPoolWorkerArg* arg = (ThreadPoolWorkerArg*)malloc(sizeof(ThreadPoolWorkerArg));
+        if (!arg) {
+            break;
+        }
+        arg->pool = pool;
+        arg->index = i;
+        if (!utils_thread_create(&pool->threads[i], thread_pool_worker, arg)) {
+            free(arg);
+            break;
+        }
+        pool->num_workers++;
+    }
+
+    if (pool->num_workers != workers) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void thread_pool_destroy(ThreadPool* pool) {
+    if (!pool) {
+        return;
+    }
+
+    utils_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    utils_cond_broadcast(&pool->work_cond);
+    utils_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->num_workers; i++) {
+        utils_thread_join(pool->threads[i]);
+    }
+
+    utils_cond_destroy(&pool->work_cond);
+    utils_cond_destroy(&pool->done_cond);
+    utils_mutex_destroy(&pool->submit_lock);
+    utils_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+size_t thread_pool_concurrency(const ThreadPool* pool) {
+    return pool ? pool->num_workers + 1 : 1;
+}
+
+Status thread_pool_parallel_for(ThreadPool* pool, size_t count, size_t grain,
+                                ParallelForFunc func, void* ctx) {
+    if (!func) {
+        return STATUS_INVALID_PARAM;
+    }
+    if (count == 0) {
+        return STATUS_SUCCESS;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    // 没有线程池或只有一块时直接在调用线程执行
+    if (!pool || pool->num_workers == 0 || count <= grain) {
+        func(0, count, 0, ctx);
+        return STATUS_SUCCESS;
+    }
+
+    utils_mutex_lock(&pool->submit_lock);
+
+    utils_mutex_lock(&pool->lock);
+    pool->func = func;
+    pool->ctx = ctx;
+    pool->count = count;
+    pool->grain = grain;
+    utils_atomic_store64(&pool->next, 0);
+    pool->active = pool->num_workers;
+    pool->generation++;
+    utils_cond_broadcast(&pool->work_cond);
+    utils_mutex_unlock(&pool->lock);
+
+    thread_pool_run_chunks(pool, func, ctx, count, grain, pool->num_workers);
+
+    utils_mutex_lock(&pool->lock);
+    while (pool->active > 0) {
+        utils_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    utils_mutex_unlock(&pool->lock);
+
+    utils_mutex_unlock(&pool->submit_lock);
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,367 @@
+// dladdr需要_GNU_SOURCE，必须在包含任何系统头文件之前定义
+#if defined(UTILS_ENABLE_TRACING) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "utils_internal.h"
+
+#ifdef UTILS_ENABLE_TRACING
+#include <dlfcn.h>
+#endif
+
+// ============================================================================
+// 函数级追踪
+//
+// 以UTILS_ENABLE_TRACING构建时，src/utils.c带-finstrument-functions编译，
+// 编译器在每个函数的入口和出口插入下面两个钩子。每个线程第一次进入钩子
+// 时分配自己的缓冲区并挂到全局链表上，之后的记录都不加锁：
+//   - 按函数地址的开放寻址哈希表：调用次数、包含子调用的累计周期、自身周期
+//   - 调用事件数组：用于输出Chrome trace-event JSON，写满后只丢弃事件
+// 本文件不带插桩编译，钩子内部调用的函数不会再次触发钩子。
+// ============================================================================
+
+#ifdef UTILS_ENABLE_TRACING
+
+#define TRACE_TABLE_SIZE 1024             // 每线程最多记录的函数数（2的幂）
+#define TRACE_MAX_DEPTH 256
+#define TRACE_EVENT_CAPACITY (64 * 1024)  // 每线程保留的调用事件数
+
+#define TRACE_NO_INSTRUMENT __attribute__((no_instrument_function))
+
+typedef struct {
+    void* function;
+    uint64_t calls;
+    uint64_t inclusive_ticks;
+    uint64_t self_ticks;
+} TraceFunctionStats;
+
+typedef struct {
+    void* function;
+    uint64_t start;
+    uint64_t child_ticks;
+} TraceFrame;
+
+typedef struct {
+    void* function;
+    uint64_t start;
+    uint64_t duration;
+} TraceEvent;
+
+typedef struct TraceThread {
+    struct TraceThread* next;
+    uint32_t thread_index;
+    size_t depth;
+    size_t overflow_depth;                // 超出TRACE_MAX_DEPTH后未记录的嵌套层数
+    uint64_t dropped_functions;
+    uint64_t dropped_events;
+    size_t event_count;
+    TraceEvent* events;
+    TraceFrame stack[TRACE_MAX_DEPTH];
+    TraceFunctionStats table[TRACE_TABLE_SIZE];
+} TraceThread;
+
+static UtilsOnce trace_once = UTILS_ONCE_INIT;
+static UtilsMutex trace_mutex;
+static TraceThread* trace_threads = NULL;
+static uint32_t trace_thread_count = 0;
+static uint64_t trace_start_ticks;
+static double trace_start_seconds;
+static UTILS_THREAD_LOCAL TraceThread* trace_current = NULL;
+
+// x86上用时间戳计数器，其他平台用单调时钟的纳秒数
+static inline TRACE_NO_INSTRUMENT uint64_t trace_ticks(void) {
+#if defined(UTILS_ARCH_X86)
+    return (uint64_t)__rdtsc();
+#else
+    return (uint64_t)(utils_now_seconds() * 1e9);
+#endif
+}
+
+static void TRACE_NO_INSTRUMENT trace_report_at_exit(void);
+
+static void TRACE_NO_INSTRUMENT trace_init(void) {
+    utils_mutex_init(&trace_mutex);
+    trace_start_ticks = trace_ticks();
+    trace_start_seconds = utils_now_seconds();
+    atexit(trace_report_at_exit);
+}
+
+static TRACE_NO_INSTRUMENT TraceThread* trace_thread_create(void) {
+    utils_call_once(&trace_once, trace_init);
+
+    TraceThread* thread = (TraceThread*)calloc(1, sizeof(TraceThread));
+    if (!thread) {
+        return NULL;
+    }
+    thread->events = (TraceEvent*)malloc(TRACE_EVENT_CAPACITY * sizeof(TraceEvent));
+
+    utils_mutex_lock(&trace_mutex);
+    thread->thread_index = ++trace_thread_count;
+    thread->next = trace_threads;
+    trace_threads = thread;
+    utils_mutex_unlock(&trace_mutex);
+    return thread;
+}
+
+static inline TRACE_NO_INSTRUMENT TraceFunctionStats* trace_lookup(TraceThread* thread, void* function) {
+    size_t index = ((uintptr_t)function >> 4) & (TRACE_TABLE_SIZE - 1);
+
+    for (size_t probe = 0; probe < TRACE_TABLE_SIZE; probe++) {
+        TraceFunctionStats* stats = &thread->table[index];
+        if (stats->function == function) {
+            return stats;
+        }
+        if (!stats->function) {
+            stats->function = function;
+            return stats;
+        }
+        index = (index + 1) & (TRACE_TABLE_SIZE - 1);
+    }
+    return NULL;
+}
+
+void TRACE_NO_INSTRUMENT __cyg_profile_func_enter(void* function, void* call_site);
+void TRACE_NO_INSTRUMENT __cyg_profile_func_exit(void* function, void* call_site);
+
+void __cyg_profile_func_enter(void* function, void* call_site) {
+    (void)call_site;
+    TraceThread* thread = trace_current;
+    if (!thread) {
+        thread = trace_current = trace_thread_create();
+        if (!thread) {
+            return;
+        }
+    }
+
+    if (thread->depth == TRACE_MAX_DEPTH) {
+        thread->overflow_depth++;
+        return;
+    }
+
+    TraceFrame* frame = &thread->stack[thread->depth++];
+    frame->function = function;
+    frame->child_ticks = 0;
+    frame->start = trace_ticks();
+}
+
+void __cyg_profile_func_exit(void* function, void* call_site) {
+    (void)function;
+    (void)call_site;
+    uint64_t end = trace_ticks();
+    TraceThread* thread = trace_current;
+    if (!thread || thread->depth == 0) {
+        return;
+    }
+    if (thread->overflow_depth > 0) {
+        thread->overflow_depth--;
+        return;
+    }
+
+    TraceFrame* frame = &thread->stack[--thread->depth];
+    uint64_t duration = end - frame->start;
+    if (thread->depth > 0) {
+        thread->stack[thread->depth - 1].child_ticks += duration;
+    }
+
+    TraceFunctionStats* stats = trace_lookup(thread, frame->function);
+    if (stats) {
+        stats->calls++;
+        stats->inclusive_ticks += duration;
+        stats->self_ticks += duration - MIN(frame->child_ticks, duration);
+    } else {
+        thread->dropped_functions++;
+    }
+
+    if (thread->events && thread->event_count < TRACE_EVENT_CAPACITY) {
+        TraceEvent* event = &thread->events[thread->event_count++];
+        event->function = frame->function;
+        event->start = frame->start;
+        event->duration = duration;
+    } else {
+        thread->dropped_events++;
+    }
+}
+
+// ============================================================================
+// 报告输出
+// ============================================================================
+
+// 每秒的tick数；运行时间太短时额外等待一段时间以保证精度
+static double TRACE_NO_INSTRUMENT trace_ticks_per_second(void) {
+#if defined(UTILS_ARCH_X86)
+    double elapsed = utils_now_seconds() - trace_start_seconds;
+    while (elapsed < 0.01) {
+        elapsed = utils_now_seconds() - trace_start_seconds;
+    }
+    return (double)(trace_ticks() - trace_start_ticks) / elapsed;
+#else
+    return 1e9;
+#endif
+}
+
+static void TRACE_NO_INSTRUMENT trace_symbol_name(void* function, char* name, size_t name_size) {
+    Dl_info info;
+    if (dladdr(function, &info) && info.dli_sname) {
+        snprintf(name, name_size, "%s", info.dli_sname);
+    } else {
+        // 静态函数不在动态符号表中
+        snprintf(name, name_size, "%p", function);
+    }
+}
+
+static int TRACE_NO_INSTRUMENT compare_stats_by_inclusive(const void* a, const void* b) {
+    const TraceFunctionStats* x = (const TraceFunctionStats*)a;
+    const TraceFunctionStats* y = (const TraceFunctionStats*)b;
+    return (x->inclusive_ticks < y->inclusive_ticks) - (x->inclusive_ticks > y->inclusive_ticks);
+}
+
+bool utils_trace_enabled(void) {
+    return true;
+}
+
+Status utils_trace_write_report(FILE* stream) {
+    if (!stream) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    utils_call_once(&trace_once, trace_init);
+    double ticks_per_second = trace_ticks_per_second();
+
+    // 合并所有线程的统计
+    size_t capacity = TRACE_TABLE_SIZE;
+    size_t count = 0;
+    TraceFunctionStats* merged = (TraceFunctionStats*)malloc(capacity * sizeof(TraceFunctionStats));
+    if (!merged) {
+        return STATUS_OUT_OF_MEMORY;
+    }
+
+    uint64_t dropped_functions = 0;
+    uint64_t dropped_events = 0;
+    uint32_t threads = 0;
+
+    utils_mutex_lock(&trace_mutex);
+    for (TraceThread* thread = trace_threads; thread; thread = thread->next) {
+        threads++;
+        dropped_functions += thread->dropped_functions;
+        dropped_events += thread->dropped_events;
+        for (size_t i = 0; i < TRACE_TABLE_SIZE; i++) {
+            const TraceFunctionStats* stats = &thread->table[i];
+            if (!stats->function || stats->calls == 0) {
+                continue;
+            }
+
+            size_t m = 0;
+            while (m < count && merged[m].function != stats->function) {
+                m++;
+            }
+            if (m == count) {
+                if (count == capacity) {
+                    TraceFunctionStats* grown = (TraceFunctionStats*)realloc(merged, capacity * 2 * sizeof(TraceFunctionStats));
+                    if (!grown) {
+                        continue;
+                    }
+                    merged = grown;
+                    capacity *= 2;
+                }
+                memset(&merged[count], 0, sizeof(merged[count]));
+                merged[count++].function = stats->function;
+            }
+            merged[m].calls += stats->calls;
+            merged[m].inclusive_ticks += stats->inclusive_ticks;
+            merged[m].self_ticks += stats->self_ticks;
+        }
+    }
+    utils_mutex_unlock(&trace_mutex);
+
+    qsort(merged, count, sizeof(TraceFunctionStats), compare_stats_by_inclusive);
+
+    fprintf(stream, "=== utils trace report (%u threads, %zu functions) ===\n", threads, count);
+    fprintf(stream, "%-36s %12s %14s %14s %12s\n", "function", "calls", "total ms", "self ms", "ns/call");
+    for (size_t i = 0; i < count; i++) {
+        char name[128];
+        trace_symbol_name(merged[i].function, name, sizeof(name));
+        double total_ms = (double)merged[i].inclusive_ticks / ticks_per_second * 1e3;
+        double self_ms = (double)merged[i].self_ticks / ticks_per_second * 1e3;
+        fprintf(stream, "%-36s %12llu %14.3f %14.3f %12.1f\n", name,
+                (unsigned long long)merged[i].calls, total_ms, self_ms,
+                total_ms * 1e6 / (double)merged[i].calls);
+    }
+    if (dropped_functions > 0 || dropped_events > 0) {
+        fprintf(stream, "(%llu calls beyond the per-thread function table, %llu trace events dropped)\n",
+                (unsigned long long)dropped_functions, (unsigned long long)dropped_events);
+    }
+
+    free(merged);
+    return STATUS_SUCCESS;
+}
+
+Status utils_trace_write_chrome_json(const char* filename) {
+    if (!filename) {
+        return STATUS_INVALID_PARAM;
+    }
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        return STATUS_FILE_NOT_FOUND;
+    }
+
+    utils_call_once(&trace_once, trace_init);
+    double ticks_per_us = trace_ticks_per_second() / 1e6;
+    bool first = true;
+
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    utils_mutex_lock(&trace_mutex);
+    for (TraceThread* thread = trace_threads; thread; thread = thread->next) {
+        for (size_t i = 0; i < thread->event_count; i++) {
+            const TraceEvent* event = &thread->events[i];
+            char name[128];
+            trace_symbol_name(event->function, name, sizeof(name));
+            fprintf(file, "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}",
+                    first ? "" : ",\n", name, thread->thread_index,
+                    (double)(event->start - trace_start_ticks) / ticks_per_us,
+                    (double)event->duration / ticks_per_us);
+            first = false;
+        }
+    }
+    utils_mutex_unlock(&trace_mutex);
+    fprintf(file, "\n]}\n");
+
+    bool failed = ferror(file) != 0;
+    failed |= fclose(file) != 0;
+    return failed ? STATUS_ERROR : STATUS_SUCCESS;
+}
+
+// UTILS_TRACE_REPORT指定报告文件（默认stderr），UTILS_TRACE_CHROME指定trace JSON文件
+static void trace_report_at_exit(void) {
+    const char* report_file = getenv("UTILS_TRACE_REPORT");
+    const char* chrome_file = getenv("UTILS_TRACE_CHROME");
+
+    FILE* stream = (report_file && report_file[0]) ? fopen(report_file, "w") : stderr;
+    if (stream) {
+        utils_trace_write_report(stream);
+        if (stream != stderr) {
+            fclose(stream);
+        }
+    }
+    if (chrome_file && chrome_file[0]) {
+        utils_trace_write_chrome_json(chrome_file);
+    }
+}
+
+#else // !UTILS_ENABLE_TRACING
+
+bool utils_trace_enabled(void) {
+    return false;
+}
+
+Status utils_trace_write_report(FILE* stream) {
+    (void)stream;
+    return STATUS_ERROR;
+}
+
+Status utils_trace_write_chrome_json(const char* filename) {
+    (void)filename;
+    return STATUS_ERROR;
+}
+
+#endif // UTILS_ENABLE_TRACING
@@ -1,15 +1,18 @@
+// 本文件提供导出的函数定义，不使用utils_inline.h的内联替换
+#define UTILS_NO_INLINE
 #include "utils.h"
 #include <stdarg.h>
 #include <math.h>
+#include <limits.h>
 
 // 全局变量定义
-int global_counter = 0;
+ShardedCounter global_counter = SHARDED_COUNTER_INIT(0);
 const int CONSTANT_VALUE = 42;
 const char* const CONSTANT_STRING = "Hello, Assembly World!";
 const Point ORIGIN_POINT = {0, 0};
 
 // 静态变量
-static int static_counter = 100;
+static ShardedCounter static_counter = SHARDED_COUNTER_INIT(100);
 
 // ============================================================================
 // 函数参数传递测试函数实现
@@ -17,12 +20,11 @@ static int static_counter = 100;
 
 // 无参数函数
 int no_params_function(void) {
-    global_counter++;
-    return global_counter * 2;
+    return (int)sharded_counter_add_fetch(&global_counter, 1) * 2;
 }
 
 void void_no_params_function(void) {
-    static_counter += 5;
+    sharded_counter_add(&static_counter, 5);
 }
 
 // 单参数函数 - 不同类型
@@ -489,6 +491,32 @@ Status test_switch_statement(Color color) {
     }
 }
 
+// 按颜色索引的结果表，超出枚举范围的值对应default分支
+static const Status switch_color_table[COLOR_BLACK + 1] = {
+    STATUS_SUCCESS,           // COLOR_RED
+    STATUS_ERROR,             // COLOR_GREEN
+    STATUS_ERROR,             // COLOR_BLUE
+    STATUS_INVALID_PARAM,     // COLOR_YELLOW
+    STATUS_OUT_OF_MEMORY,     // COLOR_CYAN
+    STATUS_OUT_OF_MEMORY,     // COLOR_MAGENTA
+    STATUS_OUT_OF_MEMORY,     // COLOR_WHITE
+    STATUS_OUT_OF_MEMORY      // COLOR_BLACK
+};
+
+Status test_switch_statement_batch(const Color* colors, size_t count, Status* results) {
+    if (!colors || !results) {
+        return STATUS_INVALID_PARAM;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        unsigned index = (unsigned)colors[i];
+        Status value = switch_color_table[index & COLOR_BLACK];
+        results[i] = (index <= COLOR_BLACK) ? value : STATUS_OUT_OF_MEMORY;
+    }
+    
+    return STATUS_SUCCESS;
+}
+
 int test_for_loop(int start, int end) {
     int sum = 0;
     for (int i = start; i <= end; i++) {
@@ -666,6 +694,7 @@ LinkedList* create_linked_list(void) {
     list->head = NULL;
     list->tail = NULL;
     list->count = 0;
+    list->arena = NULL;
     
     return list;
 }
@@ -675,7 +704,9 @@ Status add_node(LinkedList* list, int data) {
         return STATUS_INVALID_PARAM;
     }
     
-    Node* new_node = (Node*)malloc(sizeof(Node));
+    Node* new_node = list->arena
+        ? (Node*)arena_alloc(list->arena, sizeof(Node), 0)
+        : (Node*)malloc(sizeof(Node));
     if (!new_node) {
         return STATUS_OUT_OF_MEMORY;
     }
@@ -716,7 +747,10 @@ Status remove_node(LinkedList* list, int data) {
                 list->tail = current->prev;
             }
             
-            free(current);
+            // 竞技场节点随竞技场统一释放
+            if (!list->arena) {
+                free(current);
+            }
             list->count--;
             return STATUS_SUCCESS;
         }
@@ -747,19 +781,25 @@ Status print_list(const LinkedList* list) {
         return STATUS_INVALID_PARAM;
     }
     
-    printf("List (count: %zu): ", list->count);
-    Node* current = list->head;
-    while (current) {
-        printf("%d ", current->data);
-        current = current->next;
+    // 整个链表先格式化到缓冲区，超过阈值时才写出一次
+    OutputBuffer buffer;
+    Status status = output_buffer_init_sink(&buffer, stdout, OUTPUT_BUFFER_DEFAULT_CAPACITY);
+    if (status != STATUS_SUCCESS) {
+        return status;
     }
-    printf("\n");
     
-    return STATUS_SUCCESS;
+    status = print_list_to_buffer(list, &buffer);
+    if (status == STATUS_SUCCESS) {
+        status = output_buffer_flush_file(&buffer, stdout);
+    }
+    output_buffer_free(&buffer);
+    
+    return status;
 }
 
 void destroy_linked_list(LinkedList* list) {
-    if (!list) {
+    // 竞技场链表的内存由arena_reset/arena_destroy回收
+    if (!list || list->arena) {
         return;
     }
     
@@ -778,30 +818,55 @@ void destroy_linked_list(LinkedList* list) {
 // ============================================================================
 
 void* safe_malloc(size_t size) {
-    if (size == 0) {
+    // 清零语义不变，但走calloc路径：大块内存来自新映射时不再逐页写零
+    return safe_calloc(1, size);
+}
+
+void* safe_calloc(size_t count, size_t size) {
+    if (count == 0 || size == 0) {
         return NULL;
     }
     
-    void* ptr = malloc(size);
-    if (ptr) {
-        memset(ptr, 0, size);
+#ifdef UTILS_USE_POOL_ALLOCATOR
+    return pool_calloc(count, size);
+#else
+    return calloc(count, size);
+#endif
+}
+
+void* safe_malloc_uninit(size_t size) {
+    // 不清零，只用于调用方会立即完整覆盖的缓冲区
+    if (size == 0) {
+        return NULL;
     }
     
-    return ptr;
+#ifdef UTILS_USE_POOL_ALLOCATOR
+    return pool_malloc(size);
+#else
+    return malloc(size);
+#endif
 }
 
 void* safe_realloc(void* ptr, size_t new_size) {
+#ifdef UTILS_USE_POOL_ALLOCATOR
+    return pool_realloc(ptr, new_size);
+#else
     if (new_size == 0) {
         free(ptr);
         return NULL;
     }
     
     return realloc(ptr, new_size);
+#endif
 }
 
 void safe_free(void** ptr) {
     if (ptr && *ptr) {
+#ifdef UTILS_USE_POOL_ALLOCATOR
+        pool_free(*ptr);
+#else
         free(*ptr);
+#endif
         *ptr = NULL;
     }
 }
@@ -974,18 +1039,73 @@ Status sort_array(int* array, size_t size, CompareFunc compare) {
     return STATUS_SUCCESS;
 }
 
+// 把逐元素回调适配为批量回调
+static void per_element_adapter(const int* chunk, size_t count, void* ctx) {
+    CallbackFunc callback = *(CallbackFunc*)ctx;
+    for (size_t i = 0; i < count; i++) {
+        callback(chunk[i]);
+    }
+}
+
 Status process_array(int* array, size_t size, CallbackFunc callback) {
     if (!array || !callback || size == 0) {
         return STATUS_INVALID_PARAM;
     }
     
-    for (size_t i = 0; i < size; i++) {
-        callback(array[i]);
+    return process_array_batched(array, size, PROCESS_ARRAY_DEFAULT_CHUNK,
+                                 per_element_adapter, &callback);
+}
+
+Status process_array_batched(const int* array, size_t size, size_t chunk_size,
+                             BatchCallbackFunc callback, void* ctx) {
+    if (!array || !callback || size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+    
+    if (chunk_size == 0) {
+        chunk_size = PROCESS_ARRAY_DEFAULT_CHUNK;
+    }
+    
+    for (size_t offset = 0; offset < size; offset += chunk_size) {
+        callback(array + offset, MIN(chunk_size, size - offset), ctx);
     }
     
     return STATUS_SUCCESS;
 }
 
+typedef struct {
+    const int* array;
+    size_t size;
+    size_t chunk_size;
+    BatchCallbackFunc callback;
+    void* ctx;
+} ParallelArrayTask;
+
+static void parallel_array_chunks(size_t begin, size_t end, size_t worker_index, void* ctx) {
+    const ParallelArrayTask* task = (const ParallelArrayTask*)ctx;
+    (void)worker_index;
+    
+    for (size_t chunk = begin; chunk < end; chunk++) {
+        size_t offset = chunk * task->chunk_size;
+        task->callback(task->array + offset, MIN(task->chunk_size, task->size - offset), task->ctx);
+    }
+}
+
+Status process_array_parallel(ThreadPool* pool, const int* array, size_t size, size_t chunk_size,
+                              BatchCallbackFunc callback, void* ctx) {
+    if (!array || !callback || size == 0) {
+        return STATUS_INVALID_PARAM;
+    }
+    
+    if (chunk_size == 0) {
+        chunk_size = PROCESS_ARRAY_DEFAULT_CHUNK;
+    }
+    
+    ParallelArrayTask task = { array, size, chunk_size, callback, ctx };
+    size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+    return thread_pool_parallel_for(pool, chunk_count, 1, parallel_array_chunks, &task);
+}
+
 Status generic_processor(void* data, size_t size, ProcessFunc processor) {
     if (!data || !processor || size == 0) {
         return STATUS_INVALID_PARAM;
@@ -1056,14 +1176,16 @@ Status goto_example(int* array, size_t size, int target) {
         return STATUS_INVALID_PARAM;
     }
     
-    for (size_t i = 0; i < size; i++) {
-        if (array[i] < 0) {
-            goto error_handling;
-        }
-        
-        if (array[i] == target) {
-            goto found;
-        }
+    // 一次向量化扫描同时查找负数和目标值
+    ScanReason reason;
+    scan_find_equal_or_negative(array, size, target, &reason);
+    
+    if (reason == SCAN_NEGATIVE) {
+        goto error_handling;
+    }
+    
+    if (reason == SCAN_EQUAL) {
+        goto found;
     }
     
     return STATUS_ERROR;
@@ -1104,6 +1226,37 @@ Status nested_switch_if(int a, int b, char op) {
     return STATUS_ERROR;
 }
 
+// nested_switch_if的操作码表：第0/1/2位分别选择'+'、'-'、'*'的成功条件，0表示无效操作码
+static const unsigned char switch_op_table[256] = {
+    ['+'] = 1u << 0,
+    ['-'] = 1u << 1,
+    ['*'] = 1u << 2
+};
+
+Status nested_switch_if_batch(const int* a, const int* b, const char* ops, size_t count, Status* results) {
+    if (!a || !b || !ops || !results) {
+        return STATUS_INVALID_PARAM;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        unsigned mask = switch_op_table[(unsigned char)ops[i]];
+        int x = a[i];
+        int y = b[i];
+        
+        // '+'的两个else分支都落到STATUS_ERROR，因此只需判断同时为正
+        unsigned add_ok = (unsigned)((x > 0) & (y > 0));
+        unsigned sub_ok = (unsigned)(x > y);
+        unsigned mul_ok = (unsigned)(((x | y) & 1) == 0);
+        unsigned success = (mask & add_ok) | ((mask >> 1) & sub_ok) | ((mask >> 2) & mul_ok);
+        unsigned valid = (mask != 0);
+        
+        // 无效: -2 (INVALID_PARAM)，条件不满足: -1 (ERROR)，满足: 0 (SUCCESS)
+        results[i] = (Status)(STATUS_INVALID_PARAM + (int)(valid * (1 + success)));
+    }
+    
+    return STATUS_SUCCESS;
+}
+
 // ============================================================================
 // 类型转换和类型安全函数
 // ============================================================================
@@ -1113,8 +1266,14 @@ Status safe_int_to_string(int value, char* buffer, size_t buffer_size) {
         return STATUS_INVALID_PARAM;
     }
     
-    int result = snprintf(buffer, buffer_size, "%d", value);
-    return (result > 0 && (size_t)result < buffer_size) ? STATUS_SUCCESS : STATUS_ERROR;
+    char digits[UTILS_INT32_MAX_CHARS];
+    size_t length = format_int32(value, digits);
+    
+    // 与snprintf一致：空间不足时写入截断结果并返回错误
+    size_t copy_length = MIN(length, buffer_size - 1);
+    memcpy(buffer, digits, copy_length);
+    buffer[copy_length] = '\0';
+    return (copy_length < length) ? STATUS_ERROR : STATUS_SUCCESS;
 }
 
 Status safe_string_to_int(const char* str, int* value) {
@@ -1215,12 +1374,15 @@ Status union_operations(DataUnion* data) {
 // ============================================================================
 
 Status increment_global_counter(void) {
-    global_counter++;
-    static_counter += 2;
+    sharded_counter_add(&global_counter, 1);
+    sharded_counter_add(&static_counter, 2);
     return STATUS_SUCCESS;
 }
 
+int get_global_counter(void) {
+    return (int)sharded_counter_read(&global_counter);
+}
+
 Status get_static_value(void) {
-    static_counter++;
-    return static_counter;
+    return (Status)sharded_counter_add_fetch(&static_counter, 1);
 } 
\ No newline at end of file
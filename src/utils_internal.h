@@ -0,0 +1,280 @@
+#ifndef UTILS_INTERNAL_H
+#define UTILS_INTERNAL_H
+
+// 库内部使用的平台抽象：互斥锁、一次性初始化、线程局部存储和原子操作
+// 不属于公开接口，只能由src/目录下的实现文件包含
+
+#include "utils.h"
+
+#ifdef PLATFORM_WINDOWS
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    // wingdi.h中的Rectangle函数和ERROR宏与utils.h冲突
+    #ifndef NOGDI
+        #define NOGDI
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <time.h>
+#endif
+
+// x86 SIMD基线（x64上SSE2总是可用）
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define UTILS_HAVE_SSE2
+    #include <emmintrin.h>
+#endif
+
+// 以/arch:AVX2或-mavx2编译时可用的AVX2路径
+#if defined(__AVX2__)
+    #define UTILS_HAVE_AVX2
+    #include <immintrin.h>
+#endif
+
+// x86上即使编译基线不含AVX2，也可以编译带目标属性的函数，运行时检测到CPU支持后再调用
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define UTILS_ARCH_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #define UTILS_TARGET_AVX2_FMA
+        #define UTILS_TARGET_AVX2
+        #define UTILS_TARGET_AVX512
+    #else
+        #define UTILS_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+        #define UTILS_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+        #define UTILS_TARGET_AVX512 __attribute__((target("avx512f,popcnt")))
+    #endif
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// 最低位1的位置，mask不能为0
+static inline unsigned utils_ctz32(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+// 缓存行大小（用于避免伪共享）
+#define UTILS_CACHE_LINE_SIZE 64
+
+// 线程局部存储
+#if defined(_MSC_VER)
+    #define UTILS_THREAD_LOCAL __declspec(thread)
+#else
+    #define UTILS_THREAD_LOCAL __thread
+#endif
+
+// ============================================================================
+// 互斥锁和一次性初始化
+// ============================================================================
+
+#ifdef PLATFORM_WINDOWS
+typedef SRWLOCK UtilsMutex;
+typedef INIT_ONCE UtilsOnce;
+#define UTILS_MUTEX_INIT SRWLOCK_INIT
+#define UTILS_ONCE_INIT INIT_ONCE_STATIC_INIT
+
+static inline void utils_mutex_init(UtilsMutex* mutex) { InitializeSRWLock(mutex); }
+static inline void utils_mutex_destroy(UtilsMutex* mutex) { (void)mutex; }
+static inline void utils_mutex_lock(UtilsMutex* mutex) { AcquireSRWLockExclusive(mutex); }
+static inline void utils_mutex_unlock(UtilsMutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+
+static inline BOOL CALLBACK utils_once_trampoline(PINIT_ONCE once, PVOID param, PVOID* context) {
+    (void)once;
+    (void)context;
+    ((void (*)(void))param)();
+    return TRUE;
+}
+
+static inline void utils_call_once(UtilsOnce* once, void (*func)(void)) {
+    InitOnceExecuteOnce(once, utils_once_trampoline, (PVOID)func, NULL);
+}
+#else
+typedef pthread_mutex_t UtilsMutex;
+typedef pthread_once_t UtilsOnce;
+#define UTILS_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define UTILS_ONCE_INIT PTHREAD_ONCE_INIT
+
+static inline void utils_mutex_init(UtilsMutex* mutex) { pthread_mutex_init(mutex, NULL); }
+static inline void utils_mutex_destroy(UtilsMutex* mutex) { pthread_mutex_destroy(mutex); }
+static inline void utils_mutex_lock(UtilsMutex* mutex) { pthread_mutex_lock(mutex); }
+static inline void utils_mutex_unlock(UtilsMutex* mutex) { pthread_mutex_unlock(mutex); }
+
+static inline void utils_call_once(UtilsOnce* once, void (*func)(void)) {
+    pthread_once(once, func);
+}
+#endif
+
+// ============================================================================
+// 条件变量和线程
+// ============================================================================
+
+#ifdef PLATFORM_WINDOWS
+typedef CONDITION_VARIABLE UtilsCond;
+typedef HANDLE UtilsThread;
+typedef DWORD (WINAPI *UtilsThreadFunc)(LPVOID arg);
+#define UTILS_THREAD_RETURN DWORD WINAPI
+
+static inline void utils_cond_init(UtilsCond* cond) { InitializeConditionVariable(cond); }
+static inline void utils_cond_destroy(UtilsCond* cond) { (void)cond; }
+static inline void utils_cond_wait(UtilsCond* cond, UtilsMutex* mutex) {
+    SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+}
+static inline void utils_cond_signal(UtilsCond* cond) { WakeConditionVariable(cond); }
+static inline void utils_cond_broadcast(UtilsCond* cond) { WakeAllConditionVariable(cond); }
+
+static inline bool utils_thread_create(UtilsThread* thread, UtilsThreadFunc func, void* arg) {
+    *thread = CreateThread(NULL, 0, func, arg, 0, NULL);
+    return *thread != NULL;
+}
+
+static inline void utils_thread_join(UtilsThread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+typedef pthread_cond_t UtilsCond;
+typedef pthread_t UtilsThread;
+typedef void* (*UtilsThreadFunc)(void* arg);
+#define UTILS_THREAD_RETURN void*
+
+static inline void utils_cond_init(UtilsCond* cond) { pthread_cond_init(cond, NULL); }
+static inline void utils_cond_destroy(UtilsCond* cond) { pthread_cond_destroy(cond); }
+static inline void utils_cond_wait(UtilsCond* cond, UtilsMutex* mutex) { pthread_cond_wait(cond, mutex); }
+static inline void utils_cond_signal(UtilsCond* cond) { pthread_cond_signal(cond); }
+static inline void utils_cond_broadcast(UtilsCond* cond) { pthread_cond_broadcast(cond); }
+
+static inline bool utils_thread_create(UtilsThread* thread, UtilsThreadFunc func, void* arg) {
+    return pthread_create(thread, NULL, func, arg) == 0;
+}
+
+static inline void utils_thread_join(UtilsThread thread) {
+    pthread_join(thread, NULL);
+}
+#endif
+
+// ============================================================================
+// 原子操作（relaxed语义，仅用于计数器）
+// ============================================================================
+
+#if defined(_MSC_VER)
+static inline int64_t utils_atomic_add64(volatile int64_t* target, int64_t delta) {
+    return InterlockedExchangeAdd64((volatile LONG64*)target, delta) + delta;
+}
+
+static inline int64_t utils_atomic_load64(volatile int64_t* target) {
+    return InterlockedCompareExchange64((volatile LONG64*)target, 0, 0);
+}
+
+static inline void utils_atomic_store64(volatile int64_t* target, int64_t value) {
+    InterlockedExchange64((volatile LONG64*)target, value);
+}
+
+static inline bool utils_atomic_cas64(volatile int64_t* target, int64_t expected, int64_t desired) {
+    return InterlockedCompareExchange64((volatile LONG64*)target, desired, expected) == expected;
+}
+#else
+static inline int64_t utils_atomic_add64(volatile int64_t* target, int64_t delta) {
+    return __atomic_add_fetch(target, delta, __ATOMIC_RELAXED);
+}
+
+static inline int64_t utils_atomic_load64(volatile int64_t* target) {
+    return __atomic_load_n(target, __ATOMIC_RELAXED);
+}
+
+static inline void utils_atomic_store64(volatile int64_t* target, int64_t value) {
+    __atomic_store_n(target, value, __ATOMIC_RELAXED);
+}
+
+static inline bool utils_atomic_cas64(volatile int64_t* target, int64_t expected, int64_t desired) {
+    return __atomic_compare_exchange_n(target, &expected, desired, false,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+#endif
+
+// 发布/获取语义的读写，用于无锁队列在线程间传递数据
+#if defined(_MSC_VER)
+static inline int64_t utils_atomic_load_acquire64(volatile int64_t* target) {
+    return InterlockedCompareExchange64((volatile LONG64*)target, 0, 0);
+}
+
+static inline void utils_atomic_store_release64(volatile int64_t* target, int64_t value) {
+    InterlockedExchange64((volatile LONG64*)target, value);
+}
+#else
+static inline int64_t utils_atomic_load_acquire64(volatile int64_t* target) {
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+}
+
+static inline void utils_atomic_store_release64(volatile int64_t* target, int64_t value) {
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+}
+#endif
+
+// 原子地把峰值更新为max(当前峰值, value)
+static inline void utils_atomic_max64(volatile int64_t* target, int64_t value) {
+    int64_t current = utils_atomic_load64(target);
+    while (value > current) {
+        if (utils_atomic_cas64(target, current, value)) {
+            break;
+        }
+        current = utils_atomic_load64(target);
+    }
+}
+
+// ============================================================================
+// 等待和计时
+// ============================================================================
+
+// 自旋等待循环中的CPU提示
+static inline void utils_cpu_relax(void) {
+#if defined(_MSC_VER)
+    YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static inline void utils_thread_yield(void) {
+#ifdef PLATFORM_WINDOWS
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static inline void utils_sleep_ms(unsigned milliseconds) {
+#ifdef PLATFORM_WINDOWS
+    Sleep(milliseconds);
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t)(milliseconds / 1000);
+    ts.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+// 单调时钟，单位秒
+static inline double utils_now_seconds(void) {
+#ifdef PLATFORM_WINDOWS
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+#endif // UTILS_INTERNAL_H